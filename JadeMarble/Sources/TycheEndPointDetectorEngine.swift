@@ -21,6 +21,7 @@
 import Foundation
 import AVFoundation
 
+import NuguUtils
 import TycheSDK
 
 public class TycheEndPointDetectorEngine {
@@ -28,9 +29,22 @@ public class TycheEndPointDetectorEngine {
     private var flushedLength: Int = 0
     private var flushLength: Int = 0
     private var engineHandle: EpdHandle?
+    /// The sample rate which `engineHandle` is created with.
+    private var engineSampleRate: Double?
     private var speexEncoder: SpeexEncoder?
     public weak var delegate: TycheEndPointDetectorEngineDelegate?
     
+    /// Audio buffers from the mic which are not put to the engine yet.
+    /// The speech must not have a gap, so the new ones are dropped when the engine falls behind.
+    private let audioBufferRing = RingBuffer<AVAudioPCMBuffer>(capacity: Const.audioBufferRingCapacity, overrunPolicy: .dropNewest)
+    /// Drains `audioBufferRing` on `epdQueue`. The signals are coalesced while it is draining.
+    private let audioBufferSource: DispatchSourceUserDataAdd
+    
+    /// The number of audio buffers dropped because the engine fell behind.
+    public var audioBufferOverrunCount: Int {
+        audioBufferRing.overrunCount
+    }
+    
     #if DEBUG
     private var inputData = Data()
     private var outputData = Data()
@@ -39,6 +53,15 @@ public class TycheEndPointDetectorEngine {
     /// The flush time for reverb removal.
     public var flushTime: Int = 100
     
+    /**
+     Keeps the engine handle after the utterance ends, so the model is not loaded again for the next one.
+     
+     The handle is shared by the engine instances, because an engine can be created for each utterance.
+     It is reset and its options are updated when the next utterance starts.
+     It is disabled by default. The kept handle is released on memory pressure or by `releaseWarmHandle()`.
+     */
+    public var isWarmHandleEnabled: Bool = false
+    
     public var state: State = .idle {
         didSet {
             if oldValue != state {
@@ -48,10 +71,35 @@ public class TycheEndPointDetectorEngine {
         }
     }
     
-    public init() {}
+    public init() {
+        audioBufferSource = DispatchSource.makeUserDataAddSource(queue: epdQueue)
+        audioBufferSource.setEventHandler { [weak self] in
+            self?.processAudioBuffers()
+        }
+        audioBufferSource.resume()
+    }
     
     deinit {
+        audioBufferSource.cancel()
         internalStop()
+        releaseEngine()
+    }
+    
+    /// Loads the model on the background queue in advance, so the first utterance doesn't wait for reading it.
+    public static func preloadModel() {
+        ModelFileRegistry.shared.preload(paths: [modelPath]) { result in
+            switch result {
+            case .success(let modelFiles):
+                modelFiles.forEach { log.debug("model is loaded: \($0.path), size: \($0.size), load time: \($0.loadTime)") }
+            case .failure(let error):
+                log.error("failed to load model: \(error)")
+            }
+        }
+    }
+    
+    /// Releases the handle kept by `isWarmHandleEnabled`. Call it when the engine is not used any more. (ex. the client is torn down)
+    public static func releaseWarmHandle() {
+        WarmHandleStore.releaseIdleHandle()
     }
     
     public func start(
@@ -89,103 +137,136 @@ public class TycheEndPointDetectorEngine {
         }
     }
     
+    /**
+     Put pcm data to the engine
+     
+     The buffer is queued without allocation and the engine takes the queued buffers at once on its queue.
+     - Important: The buffer is not copied. It must not be modified or reused by the caller after it is put.
+     - Parameter buffer: PCM buffer contained voice data
+     */
     public func putAudioBuffer(buffer: AVAudioPCMBuffer) {
+        if audioBufferRing.push(buffer) == false {
+            log.warning("engine falls behind. the audio buffer is dropped (total: \(audioBufferRing.overrunCount))")
+        }
+        audioBufferSource.add(data: 1)
+    }
+    
+    public func stop() {
+        log.debug("try to stop")
+        
         epdQueue.async { [weak self] in
-            guard let self = self else { return }
-            guard let ptrPcmData = buffer.int16ChannelData?.pointee,
-                0 < buffer.frameLength else {
-                log.warning("There's no 16bit audio data.")
-                return
-            }
-
-            let (engineState, inputData) = ptrPcmData.withMemoryRebound(to: UInt8.self, capacity: Int(buffer.frameLength * 2)) { (ptrData) -> (Int32, Data) in
-                #if DEBUG
-                self.inputData.append(ptrData, count: Int(buffer.frameLength) * 2)
-                #endif
-                let inputData = Data(bytes: ptrData, count: Int(buffer.frameLength) * 2)
-                
-                // Calculate flushed audio frame length.
-                var adjustLength = 0
-                if self.flushedLength + Int(buffer.frameLength) <= self.flushLength {
-                    self.flushedLength += Int(buffer.frameLength)
-                    return (-1, inputData)
-                } else if self.flushedLength < self.flushLength {
-                    self.flushedLength += Int(buffer.frameLength)
-                    adjustLength = Int(buffer.frameLength) - (self.flushedLength - self.flushLength)
-                }
-                
-                let engineState = epdClientChannelRUN(
-                    self.engineHandle,
-                    ptrData,
-                    myint(UInt32(buffer.frameLength) - UInt32(adjustLength)) * 2, // data length is double of frame length, because It is 16bit audio data.
-                    0
-                )
-                
-                return (engineState, inputData)
-            }
-            guard .zero <= engineState else { return }
-            
-            guard let speexEncoder else {
-                log.error("SpeexEncoder is not exist. Please initDetectorEngine first.")
-                return
-            }
+            self?.internalStop()
+        }
+    }
+    
+    private func processAudioBuffers() {
+        audioBufferRing.drain { buffer in
+            process(buffer: buffer)
+        }
+    }
+    
+    private func process(buffer: AVAudioPCMBuffer) {
+        // The warm handle must not take the audio after the utterance ends.
+        guard [.listening, .start].contains(state) else { return }
+        
+        guard let ptrPcmData = buffer.int16ChannelData?.pointee,
+            0 < buffer.frameLength else {
+            log.warning("There's no 16bit audio data.")
+            return
+        }
+        
+        // The buffer is shared with the other consumers. It is read only and copied once only when the speech is extracted.
+        let engineState = ptrPcmData.withMemoryRebound(to: UInt8.self, capacity: Int(buffer.frameLength * 2)) { (ptrData) -> Int32 in
+            #if DEBUG
+            self.inputData.append(ptrData, count: Int(buffer.frameLength) * 2)
+            #endif
             
-            do {
-                let speexData = try speexEncoder.encode(data: inputData)
-                self.delegate?.tycheEndPointDetectorEngineDidExtract(speechData: speexData)
-                #if DEBUG
-                self.outputData.append(speexData)
-                #endif
-            } catch {
-                log.error("Failed to speex encoding, error: \(error)")
+            // Calculate flushed audio frame length.
+            var adjustLength = 0
+            if self.flushedLength + Int(buffer.frameLength) <= self.flushLength {
+                self.flushedLength += Int(buffer.frameLength)
+                return -1
+            } else if self.flushedLength < self.flushLength {
+                self.flushedLength += Int(buffer.frameLength)
+                adjustLength = Int(buffer.frameLength) - (self.flushedLength - self.flushLength)
             }
             
-            self.state = TycheEndPointDetectorEngine.State(engineState: engineState)
+            let engineState = epdClientChannelRUN(
+                self.engineHandle,
+                ptrData,
+                myint(UInt32(buffer.frameLength) - UInt32(adjustLength)) * 2, // data length is double of frame length, because It is 16bit audio data.
+                0
+            )
             
+            return engineState
+        }
+        guard .zero <= engineState else { return }
+        
+        let inputData = Data(bytes: ptrPcmData, count: Int(buffer.frameLength) * 2)
+        
+        guard let speexEncoder else {
+            log.error("SpeexEncoder is not exist. Please initDetectorEngine first.")
+            return
+        }
+        
+        do {
+            let speexData = try speexEncoder.encode(data: inputData)
+            self.delegate?.tycheEndPointDetectorEngineDidExtract(speechData: speexData)
             #if DEBUG
-            if self.state == .end {
-                do {
-                    let epdInputFileName = FileManager.default.urls(for: .documentDirectory,
-                                                                    in: .userDomainMask)[0].appendingPathComponent("jade_marble_input.raw")
-                    log.debug("input data file :\(epdInputFileName)")
-                    try self.inputData.write(to: epdInputFileName)
-                    
-                    let speexFileName = FileManager.default.urls(for: .documentDirectory,
-                                                                 in: .userDomainMask)[0].appendingPathComponent("jade_marble_output.speex")
-                    log.debug("speex data file :\(speexFileName)")
-                    try self.outputData.write(to: speexFileName)
-                    
-                    self.inputData.removeAll()
-                    self.outputData.removeAll()
-                } catch {
-                    log.debug(error)
-                }
-            }
+            self.outputData.append(speexData)
             #endif
-            
-            if [.idle, .listening, .start].contains(self.state) == false {
-                self.internalStop()
+        } catch {
+            log.error("Failed to speex encoding, error: \(error)")
+        }
+        
+        self.state = TycheEndPointDetectorEngine.State(engineState: engineState)
+        
+        #if DEBUG
+        if self.state == .end {
+            do {
+                let epdInputFileName = FileManager.default.urls(for: .documentDirectory,
+                                                                in: .userDomainMask)[0].appendingPathComponent("jade_marble_input.raw")
+                log.debug("input data file :\(epdInputFileName)")
+                try self.inputData.write(to: epdInputFileName)
+                
+                let speexFileName = FileManager.default.urls(for: .documentDirectory,
+                                                             in: .userDomainMask)[0].appendingPathComponent("jade_marble_output.speex")
+                log.debug("speex data file :\(speexFileName)")
+                try self.outputData.write(to: speexFileName)
+                
+                self.inputData.removeAll()
+                self.outputData.removeAll()
+            } catch {
+                log.debug(error)
             }
         }
-    }
-    
-    public func stop() {
-        log.debug("try to stop")
+        #endif
         
-        epdQueue.async { [weak self] in
-            self?.internalStop()
+        if [.idle, .listening, .start].contains(self.state) == false {
+            self.internalStop()
         }
     }
     
     private func internalStop() {
+        if isWarmHandleEnabled, let engineHandle = engineHandle, let engineSampleRate = engineSampleRate {
+            WarmHandleStore.put(engineHandle, sampleRate: engineSampleRate)
+            self.engineHandle = nil
+            self.engineSampleRate = nil
+        } else {
+            releaseEngine()
+        }
+        
+        speexEncoder = nil
+        state = .idle
+    }
+    
+    private func releaseEngine() {
         if engineHandle != nil {
             epdClientChannelRELEASE(engineHandle)
             engineHandle = nil
+            engineSampleRate = nil
             log.debug("engine is destroyed")
         }
-        
-        speexEncoder = nil
-        state = .idle
     }
     
     private func initDetectorEngine(
@@ -194,24 +275,39 @@ public class TycheEndPointDetectorEngine {
         maxDuration: Int,
         pauseLength: Int
     ) throws {
-        if engineHandle != nil {
-            epdClientChannelRELEASE(engineHandle)
+        let speexEncoder = SpeexEncoder(sampleRate: Int(sampleRate), inputType: EndPointDetectorConst.inputStreamType)
+        self.speexEncoder = speexEncoder
+        
+        if engineHandle == nil, isWarmHandleEnabled, let warmHandle = WarmHandleStore.take(sampleRate: sampleRate) {
+            engineHandle = warmHandle
+            engineSampleRate = sampleRate
         }
         
-        #if DEPLOY_OTHER_PACKAGE_MANAGER
-        let modelPath = Bundle(for: TycheEndPointDetectorEngine.self).url(forResource: "skt_epd_model", withExtension: "raw")!.path
-        #else
-        let modelPath = Bundle.module.url(forResource: "skt_epd_model", withExtension: "raw")!.path
-        #endif
+        if let engineHandle = engineHandle, engineSampleRate == sampleRate {
+            // Reuse the warm handle. The options are updated in place.
+            if 0 <= epdClientChannelRESET(engineHandle, Const.epdMode),
+                0 <= setMaxSpeechDur(engineHandle, myint(maxDuration), myint(timeout), myint(pauseLength)) {
+                log.debug("engine is reset")
+                return
+            }
+            
+            log.warning("failed to reset engine. it will be created again")
+        }
+        
+        releaseEngine()
+        
+        // The model is read from the page cache if it is preloaded. The loading in progress is not waited for.
+        let modelPath = Self.modelPath
+        if ModelFileRegistry.shared.loadedModelFile(path: modelPath) == nil {
+            log.debug("model is not preloaded. the engine reads it from the file")
+        }
         
-        let speexEncoder = SpeexEncoder(sampleRate: Int(sampleRate), inputType: EndPointDetectorConst.inputStreamType)
-        self.speexEncoder = speexEncoder
         guard let epdHandle = epdClientChannelSTART(
             modelPath,
             myint(sampleRate),
             myint(EndPointDetectorConst.inputStreamType.rawValue),
             myint(EndPointDetectorConst.outputStreamType.rawValue),
-            1,
+            Const.epdMode,
             myint(maxDuration),
             myint(timeout),
             myint(pauseLength)
@@ -220,5 +316,85 @@ public class TycheEndPointDetectorEngine {
         }
         
         self.engineHandle = epdHandle
+        engineSampleRate = sampleRate
+    }
+}
+
+// MARK: - Const
+
+private extension TycheEndPointDetectorEngine {
+    enum Const {
+        /// 5 seconds of 100ms buffers.
+        static let audioBufferRingCapacity = 50
+        static let epdMode: myint = 1
+    }
+    
+    static var modelPath: String {
+        #if DEPLOY_OTHER_PACKAGE_MANAGER
+        return Bundle(for: TycheEndPointDetectorEngine.self).url(forResource: "skt_epd_model", withExtension: "raw")!.path
+        #else
+        return Bundle.module.url(forResource: "skt_epd_model", withExtension: "raw")!.path
+        #endif
+    }
+}
+
+// MARK: - WarmHandleStore
+
+/**
+ Keeps the warm handle which is not used by any engine.
+ 
+ The handle is kept out of the engine instance, because an engine can be created for each utterance. (ex. `ClientEndPointDetector`)
+ */
+private enum WarmHandleStore {
+    @Atomic private static var idleHandle: (handle: EpdHandle, sampleRate: Double)?
+    /// Releases the idle handle when the system is low on memory.
+    private static let memoryPressureSource: DispatchSourceMemoryPressure = {
+        let source = DispatchSource.makeMemoryPressureSource(eventMask: [.warning, .critical], queue: .global(qos: .utility))
+        source.setEventHandler {
+            log.debug("memory pressure")
+            WarmHandleStore.releaseIdleHandle()
+        }
+        source.resume()
+        return source
+    }()
+    
+    static func put(_ handle: EpdHandle, sampleRate: Double) {
+        _ = memoryPressureSource
+        
+        var lastHandle: EpdHandle?
+        _idleHandle.mutate {
+            lastHandle = $0?.handle
+            $0 = (handle: handle, sampleRate: sampleRate)
+        }
+        
+        if let lastHandle = lastHandle {
+            epdClientChannelRELEASE(lastHandle)
+        }
+    }
+    
+    /// - Returns: The idle handle which is created with `sampleRate`.
+    static func take(sampleRate: Double) -> EpdHandle? {
+        var handle: EpdHandle?
+        _idleHandle.mutate {
+            guard $0?.sampleRate == sampleRate else { return }
+            
+            handle = $0?.handle
+            $0 = nil
+        }
+        
+        return handle
+    }
+    
+    static func releaseIdleHandle() {
+        var idleHandle: EpdHandle?
+        _idleHandle.mutate {
+            idleHandle = $0?.handle
+            $0 = nil
+        }
+        
+        if let idleHandle = idleHandle {
+            epdClientChannelRELEASE(idleHandle)
+            log.debug("idle engine is destroyed")
+        }
     }
 }
@@ -162,4 +162,8 @@ public enum Keyword: CustomStringConvertible, CaseIterable {
         }
         #endif
     }
+    
+    var modelFilePaths: [String] {
+        return [netFilePath, searchFilePath]
+    }
 }
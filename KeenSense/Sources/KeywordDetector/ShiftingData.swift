@@ -25,28 +25,19 @@ import Foundation
  This Data Structure size is limited.
  When the new data comes, calculate total data size to be then drops oldest bytes.
  It can be usefull for keeping latest certain byte size of data.
+ 
+ The storage is allocated once and used as a ring. So appending doesn't allocate or shift the kept bytes.
  */
 class ShiftingData {
     private let capacity: Int
-    private var internalData = Data()
+    private var storage: [UInt8]
+    /// The index of the oldest byte in `storage`.
+    private var headIndex = 0
+    private(set) var count = 0
     
     init(capacity: Int) {
         self.capacity = capacity
-    }
-    
-    public var count: Int {
-        return internalData.count
-    }
-    
-    /**
-     Make some space for appending
-     */
-    private func adjustSize(by neededSize: Int) {
-        let availableLength = capacity - (internalData.count + neededSize)
-        if availableLength < 0 {
-            let neededLength = abs(availableLength)
-            internalData = internalData.subdata(in: neededLength..<internalData.count)
-        }
+        storage = [UInt8](repeating: 0, count: capacity)
     }
     
     /**
@@ -54,19 +45,53 @@ class ShiftingData {
      This Data Structure keeps Certain size of latest bytes.
      */
     func append(_ other: Data) {
-        adjustSize(by: other.count)
-        internalData.append(other)
+        other.withUnsafeBytes { append($0) }
+    }
+    
+    /// Appends the bytes without making intermediate `Data`.
+    func append(_ bytes: UnsafeRawBufferPointer) {
+        guard 0 < capacity, let baseAddress = bytes.baseAddress, 0 < bytes.count else { return }
+        
+        // Only the latest bytes can be kept.
+        let length = min(bytes.count, capacity)
+        let source = baseAddress + (bytes.count - length)
+        storage.withUnsafeMutableBytes { storageBuffer in
+            var writeIndex = (headIndex + count) % capacity
+            var offset = 0
+            while offset < length {
+                let chunkLength = min(length - offset, capacity - writeIndex)
+                (storageBuffer.baseAddress! + writeIndex).copyMemory(from: source + offset, byteCount: chunkLength)
+                offset += chunkLength
+                writeIndex = (writeIndex + chunkLength) % capacity
+            }
+        }
+        
+        let droppedLength = max(count + length - capacity, 0)
+        headIndex = (headIndex + droppedLength) % capacity
+        count = min(count + length, capacity)
     }
     
     func subdata(in range: Range<Data.Index>) -> Data {
-        return internalData.subdata(in: range)
+        var data = Data(capacity: range.count)
+        storage.withUnsafeBytes { storageBuffer in
+            var index = range.lowerBound
+            while index < range.upperBound {
+                let storageIndex = (headIndex + index) % capacity
+                let chunkLength = min(range.upperBound - index, capacity - storageIndex)
+                data.append(storageBuffer.bindMemory(to: UInt8.self).baseAddress! + storageIndex, count: chunkLength)
+                index += chunkLength
+            }
+        }
+        
+        return data
     }
     
     func removeAll() {
-        internalData.removeAll()
+        headIndex = 0
+        count = 0
     }
     
     func write(to: URL) throws {
-        try internalData.write(to: to)
+        try subdata(in: 0..<count).write(to: to)
     }
 }
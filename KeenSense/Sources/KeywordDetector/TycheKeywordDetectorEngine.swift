@@ -33,10 +33,24 @@ import TycheSDK
 public class TycheKeywordDetectorEngine: TypedNotifyable {
     private let kwdQueue = DispatchQueue(label: "com.sktelecom.romaine.keensense.tyche_key_word_detector")
     private var engineHandle: WakeupHandle?
+    /// The model files which `engineHandle` is created with.
+    private var engineModelFiles: [ModelFileIdentity]?
+    /// Destroys the inactive `engineHandle` when the system is low on memory.
+    private let memoryPressureSource: DispatchSourceMemoryPressure
     
     /// Window buffer for user's voice. This will help extract certain section of speaking keyword
     private var detectingData = ShiftingData(capacity: Int(KeywordDetectorConst.sampleRate*5*2))
     
+    /// Audio buffers from the mic which are not put to the engine yet. The latest ones are kept when the engine falls behind.
+    private let audioBufferRing = RingBuffer<AVAudioPCMBuffer>(capacity: Const.audioBufferRingCapacity, overrunPolicy: .dropOldest)
+    /// Drains `audioBufferRing` on `kwdQueue`. The signals are coalesced while it is draining.
+    private let audioBufferSource: DispatchSourceUserDataAdd
+    
+    /// The number of audio buffers dropped because the engine fell behind.
+    public var audioBufferOverrunCount: Int {
+        audioBufferRing.overrunCount
+    }
+    
     /// Tyche Keyword detector engine state
     public var state: TycheKeywordDetectorEngine.State = .inactive {
         didSet {
@@ -54,21 +68,75 @@ public class TycheKeywordDetectorEngine: TypedNotifyable {
         }
         
         set {
+            // Switching the keyword doesn't wait for reading the model files on `kwdQueue`.
+            Self.preloadModels(for: [newValue])
+            
             kwdQueue.async { [weak self] in
-                self?.internalKeyword = newValue
+                guard let self = self else { return }
+                
+                // The model files of the replaced keyword are not needed any more.
+                Set(self.internalKeyword.modelFilePaths)
+                    .subtracting(newValue.modelFilePaths)
+                    .forEach { ModelFileRegistry.shared.unload(path: $0) }
+                self.internalKeyword = newValue
             }
         }
     }
     private var internalKeyword: Keyword = .aria
     
+    /**
+     Keeps the engine handle after the detection or stop, so the model files are not read again for the next session.
+     
+     The handle is reset to detect again when it starts.
+     It is created again when the model files are changed, even if a custom model file is replaced at the same path.
+     It is disabled by default. The handle is destroyed on memory pressure or when this engine is deinitialized.
+     */
+    public var isWarmHandleEnabled: Bool = false
+    
     #if DEBUG
     private let filename = FileManager.default.urls(for: .documentDirectory, in: .userDomainMask)[0].appendingPathComponent("detecting.raw")
     #endif
     
-    public init() {}
+    public init() {
+        Self.preloadModels(for: [internalKeyword])
+        
+        audioBufferSource = DispatchSource.makeUserDataAddSource(queue: kwdQueue)
+        audioBufferSource.setEventHandler { [weak self] in
+            self?.processAudioBuffers()
+        }
+        audioBufferSource.resume()
+        
+        memoryPressureSource = DispatchSource.makeMemoryPressureSource(eventMask: [.warning, .critical], queue: kwdQueue)
+        memoryPressureSource.setEventHandler { [weak self] in
+            guard let self = self, self.state == .inactive else { return }
+            
+            log.debug("memory pressure")
+            self.destroyEngine()
+        }
+        memoryPressureSource.resume()
+    }
     
     deinit {
+        audioBufferSource.cancel()
+        memoryPressureSource.cancel()
         internalStop()
+        destroyEngine()
+    }
+    
+    /**
+     Loads the model files of keywords on the background queue in advance, so the detection starts without reading them.
+     
+     The model files are kept in the memory. So load only the keywords which will be detected.
+     */
+    public static func preloadModels(for keywords: [Keyword]) {
+        ModelFileRegistry.shared.preload(paths: keywords.flatMap { $0.modelFilePaths }) { result in
+            switch result {
+            case .success(let modelFiles):
+                modelFiles.forEach { log.debug("model is loaded: \($0.path), size: \($0.size), load time: \($0.loadTime)") }
+            case .failure(let error):
+                log.error("failed to load model: \(error)")
+            }
+        }
     }
     
     /**
@@ -80,8 +148,8 @@ public class TycheKeywordDetectorEngine: TypedNotifyable {
         kwdQueue.async { [weak self] in
             guard let self = self else { return }
             
-            if self.engineHandle != nil {
-                // Release last components
+            if self.state == .active {
+                // Stop last session
                 self.internalStop()
             }
             
@@ -102,49 +170,66 @@ public class TycheKeywordDetectorEngine: TypedNotifyable {
 
     /**
      Put  pcm data to the engine
+     
+     The buffer is queued without allocation and the engine takes the queued buffers at once on its queue.
+     - Important: The buffer is not copied. It must not be modified or reused by the caller after it is put.
      - Parameter buffer: PCM buffer contained voice data
      */
     public func putAudioBuffer(buffer: AVAudioPCMBuffer) {
+        if audioBufferRing.push(buffer) == false {
+            log.warning("engine falls behind. the oldest audio buffer is dropped (total: \(audioBufferRing.overrunCount))")
+        }
+        audioBufferSource.add(data: 1)
+    }
+    
+    /**
+     Stop keyword Detection.
+     */
+    public func stop() {
+        log.debug("try to stop")
+        
         kwdQueue.async { [weak self] in
-            guard let self = self else { return }
+            self?.internalStop()
+        }
+    }
+    
+    private func processAudioBuffers() {
+        audioBufferRing.drain { buffer in
+            // The warm handle must not take the audio after the detection or stop.
+            guard state == .active else { return }
             guard let ptrPcmData = buffer.int16ChannelData?.pointee,
                 0 < buffer.frameLength else {
                     log.warning("There's no 16bit audio data.")
                     return
             }
             
-            ptrPcmData.withMemoryRebound(to: UInt8.self, capacity: Int(buffer.frameLength*2)) { (ptrData: UnsafeMutablePointer<UInt8>) -> Void in
-                self.detectingData.append(Data(bytes: ptrData, count: Int(buffer.frameLength)*2))
-            }
+            // The buffer is shared with the other consumers. It is read only and copied into the window directly.
+            detectingData.append(UnsafeRawBufferPointer(start: ptrPcmData, count: Int(buffer.frameLength)*2))
             
-            let isDetected = Wakeup_PutAudio(self.engineHandle, ptrPcmData, Int32(buffer.frameLength)) == 1
+            let isDetected = Wakeup_PutAudio(engineHandle, ptrPcmData, Int32(buffer.frameLength)) == 1
             if isDetected {
                 log.debug("detected")
-                self.notifyDetection()
-                self.internalStop()
+                notifyDetection()
+                internalStop()
             }
         }
     }
     
-    /**
-     Stop keyword Detection.
-     */
-    public func stop() {
-        log.debug("try to stop")
-        
-        kwdQueue.async { [weak self] in
-            self?.internalStop()
+    private func internalStop() {
+        if isWarmHandleEnabled == false {
+            destroyEngine()
         }
+        
+        state = .inactive
     }
     
-    private func internalStop() {
+    private func destroyEngine() {
         if engineHandle != nil {
             Wakeup_Destroy(engineHandle)
             engineHandle = nil
+            engineModelFiles = nil
             log.debug("engine is destroyed")
         }
-        
-        state = .inactive
     }
 }
 
@@ -158,8 +243,23 @@ extension TycheKeywordDetectorEngine {
      Then only you have to do is making decision which key word you use.
      */
     private func initTriggerEngine() throws {
-        if engineHandle != nil {
-            Wakeup_Destroy(engineHandle)
+        let keyword = self.keyword
+        // The file replaced at the same path has the other identity. (ex. the custom model file is updated)
+        let modelFiles = keyword.modelFilePaths.compactMap(ModelFileIdentity.init(path:))
+        if let engineHandle = engineHandle,
+           modelFiles.count == keyword.modelFilePaths.count,
+           engineModelFiles == modelFiles {
+            // Re-arm the warm handle.
+            Wakeup_Reset(engineHandle)
+            log.debug("engine is reset")
+            return
+        }
+        
+        destroyEngine()
+        
+        // The model files are read from the page cache if they are preloaded. The loading in progress is not waited for.
+        if keyword.modelFilePaths.contains(where: { ModelFileRegistry.shared.loadedModelFile(path: $0) == nil }) {
+            log.debug("model files are not preloaded. the engine reads them from the files")
         }
         
         guard let wakeUpHandle = Wakeup_Create(keyword.netFilePath, keyword.searchFilePath, 0) else {
@@ -167,6 +267,32 @@ extension TycheKeywordDetectorEngine {
         }
         
         engineHandle = wakeUpHandle
+        engineModelFiles = modelFiles
+    }
+}
+
+// MARK: - ModelFileIdentity
+
+private extension TycheKeywordDetectorEngine {
+    /// Identity of the model file. It is compared to tell whether the warm handle is created with the same file.
+    struct ModelFileIdentity: Equatable {
+        let path: String
+        let device: dev_t
+        let inode: ino_t
+        let size: off_t
+        let modificationTime: TimeInterval
+        
+        /// Returns `nil` if the file status cannot be read.
+        init?(path: String) {
+            var fileStatus = stat()
+            guard stat(path, &fileStatus) == 0 else { return nil }
+            
+            self.path = path
+            device = fileStatus.st_dev
+            inode = fileStatus.st_ino
+            size = fileStatus.st_size
+            modificationTime = TimeInterval(fileStatus.st_mtimespec.tv_sec) + TimeInterval(fileStatus.st_mtimespec.tv_nsec) / 1_000_000_000
+        }
     }
 }
 
@@ -262,3 +388,12 @@ public extension TycheKeywordDetectorEngine {
         }
     }
 }
+
+// MARK: - Const
+
+private extension TycheKeywordDetectorEngine {
+    enum Const {
+        /// 2 seconds of 100ms buffers.
+        static let audioBufferRingCapacity = 20
+    }
+}
@@ -101,7 +101,7 @@ final class AudioPlayer {
         }
         
         do {
-            try dataSource.appendData(attachment.content)
+            try dataSource.appendData(attachment.contentSegments, isCompleted: attachment.isCompleted)
             
             if attachment.isEnd {
                 lastDataAppended = true
@@ -34,6 +34,13 @@ public final class ASRAgent: ASRAgentProtocol {
     
     public weak var delegate: ASRAgentDelegate?
     
+    /**
+     Keeps the engine of the client side end point detector after the utterance ends, so the model is not loaded again for the next one.
+     
+     It is disabled by default. The kept engine is released on memory pressure or by `releaseWarmEndPointDetector()`.
+     */
+    public var isWarmEndPointDetectorEnabled = false
+    
     // Private
     private let focusManager: FocusManageable
     private let contextManager: ContextManageable
@@ -59,8 +66,15 @@ public final class ASRAgent: ASRAgentProtocol {
     // Observers
     private let notificationCenter = NotificationCenter.default
     private var playSyncObserver: Any?
+    private var uploadBufferStateObserver: Any?
     
-    public var options: ASROptions = ASROptions(endPointing: .client)
+    public var options: ASROptions = ASROptions(endPointing: .client) {
+        didSet {
+            guard oldValue.endPointing != options.endPointing else { return }
+            
+            preloadEndPointDetectorModel()
+        }
+    }
     private(set) public var asrState: ASRState = .idle {
         didSet {
             log.info("From:\(oldValue) To:\(asrState)")
@@ -161,6 +175,14 @@ public final class ASRAgent: ASRAgentProtocol {
     // For Recognize Event
     @Atomic private var asrRequest: ASRRequest?
     private var attachmentSeq: Int32 = 0
+    private let attachmentAggregator = ASRAttachmentAggregator(maxMergedCount: 5)
+    /**
+     The upload watermarks of the Recognize event stream.
+     
+     A speech data is 100 ms of Speex which is a few hundred bytes. So the high watermark is about 10 speech data and the low watermark is about 2.
+     It is larger than the Recognize event part. So the event alone is not regarded as a stall.
+     */
+    private static let recognizeUploadWatermark = DataBoundInputStream.Watermark(high: 4 * 1024, low: 1024)
     
     private lazy var disposeBag = DisposeBag()
     private var expectSpeech: ASRExpectSpeech? {
@@ -226,9 +248,20 @@ public final class ASRAgent: ASRAgentProtocol {
         self.interactionControlManager = interactionControlManager
         
         addPlaySyncObserver(playSyncManager)
+        if let streamDataRouter = upstreamDataSender as? StreamDataRoutable {
+            addStreamDataObserver(streamDataRouter)
+        }
+        if let streamDataRouter = upstreamDataSender as? StreamDataRouter {
+            streamDataRouter.setUploadBufferWatermark(ASRAgent.recognizeUploadWatermark, forEvent: "ASR.Recognize")
+        }
         contextManager.addProvider(contextInfoProvider)
         focusManager.add(channelDelegate: self)
         directiveSequencer.add(directiveHandleInfos: handleableDirectiveInfos.asDictionary)
+        
+        // `options` is set after the initialization. So it is checked on the queue.
+        asrDispatchQueue.async { [weak self] in
+            self?.preloadEndPointDetectorModel()
+        }
     }
     
     deinit {
@@ -236,6 +269,10 @@ public final class ASRAgent: ASRAgentProtocol {
             notificationCenter.removeObserver(playSyncObserver)
         }
         
+        if let uploadBufferStateObserver = uploadBufferStateObserver {
+            notificationCenter.removeObserver(uploadBufferStateObserver)
+        }
+        
         contextManager.removeProvider(contextInfoProvider)
         directiveSequencer.remove(directiveHandleInfos: handleableDirectiveInfos.asDictionary)
     }
@@ -303,6 +340,21 @@ public extension ASRAgent {
         endPointDetector?.putAudioBuffer(buffer: buffer)
     }
     
+    /**
+     Put the audio buffer of `MicInputProvider` without copying.
+     
+     It is only for `SpeechRecognizerAggregator` which shares the buffer with the keyword detector. The others use `putAudioBuffer(buffer:)`.
+     */
+    @_spi(SharedAudioBuffer)
+    func putSharedAudioBuffer(buffer: AVAudioPCMBuffer) {
+        endPointDetector?.putSharedAudioBuffer(buffer: buffer)
+    }
+    
+    /// Releases the end point detector engine kept by `isWarmEndPointDetectorEnabled`.
+    static func releaseWarmEndPointDetector() {
+        TycheEndPointDetectorEngine.releaseWarmHandle()
+    }
+    
     func stopRecognition() {
         log.debug("")
         asrDispatchQueue.async { [weak self] in
@@ -405,17 +457,10 @@ extension ASRAgent: EndPointDetectorDelegate {
                 return
             }
             
-            let attachment = Attachment(typeInfo: .recognize).makeAttachmentMessage(
-                property: self.capabilityAgentProperty,
-                dialogRequestId: asrRequest.eventIdentifier.dialogRequestId,
-                referrerDialogRequestId: asrRequest.referrerDialogRequestId,
-                attachmentSeq: self.attachmentSeq,
-                isEnd: false,
-                speechData: speechData
-            )
-            self.upstreamDataSender.sendStream(attachment)
-            self.attachmentSeq += 1
-            log.debug("request seq: \(self.attachmentSeq-1)")
+            // Speech data is merged while the upload is congested.
+            guard let aggregatedSpeechData = self.attachmentAggregator.append(speechData) else { return }
+            
+            self.sendSpeechData(aggregatedSpeechData, asrRequest: asrRequest)
         }
     }
 }
@@ -597,6 +642,13 @@ private extension ASRAgent {
 // MARK: - Private(EndPointDetector)
 
 private extension ASRAgent {
+    /// The client side end point detector reads the model at the first utterance. So the model is loaded in advance only for it.
+    func preloadEndPointDetectorModel() {
+        guard options.endPointing == .client else { return }
+        
+        TycheEndPointDetectorEngine.preloadModel()
+    }
+    
     /// asrDispatchQueue
     func executeStartCapture() {
         guard let asrRequest = asrRequest else {
@@ -642,9 +694,10 @@ private extension ASRAgent {
         }
         
         attachmentSeq = 0
+        attachmentAggregator.reset()
         switch asrRequest.options.endPointing {
         case .client:
-            endPointDetector = ClientEndPointDetector(asrOptions: asrRequest.options)
+            endPointDetector = ClientEndPointDetector(asrOptions: asrRequest.options, isWarmHandleEnabled: isWarmEndPointDetectorEnabled)
         case .server:
             // TODO: after server preparation.
             log.error("Server side end point detector does not support yet.")
@@ -682,6 +735,10 @@ private extension ASRAgent {
         }
         
         asrState = .busy
+        
+        if let pendingSpeechData = attachmentAggregator.flush() {
+            sendSpeechData(pendingSpeechData, asrRequest: asrRequest)
+        }
 
         let attachment = Attachment(typeInfo: .recognize).makeAttachmentMessage(
             property: self.capabilityAgentProperty,
@@ -694,6 +751,21 @@ private extension ASRAgent {
         upstreamDataSender.sendStream(attachment)
     }
     
+    /// asrDispatchQueue
+    func sendSpeechData(_ speechData: Data, asrRequest: ASRRequest) {
+        let attachment = Attachment(typeInfo: .recognize).makeAttachmentMessage(
+            property: self.capabilityAgentProperty,
+            dialogRequestId: asrRequest.eventIdentifier.dialogRequestId,
+            referrerDialogRequestId: asrRequest.referrerDialogRequestId,
+            attachmentSeq: self.attachmentSeq,
+            isEnd: false,
+            speechData: speechData
+        )
+        upstreamDataSender.sendStream(attachment)
+        attachmentSeq += 1
+        log.debug("request seq: \(attachmentSeq-1), size: \(speechData.count)")
+    }
+    
     /// asrDispatchQueue
     func startRecognition(
         initiator: ASRInitiator,
@@ -797,4 +869,14 @@ private extension ASRAgent {
             }
         }
     }
+    
+    func addStreamDataObserver(_ object: StreamDataRoutable) {
+        uploadBufferStateObserver = object.observe(NuguCoreNotification.StreamDataRoute.UploadBufferStateChanged.self, queue: nil) { [weak self] (notification) in
+            self?.asrDispatchQueue.async { [weak self] in
+                guard let self = self, self.asrRequest?.eventIdentifier.dialogRequestId == notification.dialogRequestId else { return }
+                
+                self.attachmentAggregator.uploadBufferStateChanged(isOverHighWatermark: notification.isOverHighWatermark)
+            }
+        }
+    }
 }
@@ -0,0 +1,89 @@
+//
+//  ASRAttachmentAggregator.swift
+//  NuguAgents
+//
+//  Created by agent on 2026/10/17.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/**
+ Merges the consecutive speech data into one attachment while the upload is congested.
+ 
+ The speech data is passed through as it is while the upload keeps up.
+ While the upload buffer is over the high watermark, up to `maxMergedCount` speech data are merged.
+ `ASRAgent` sets the watermarks of the Recognize stream to about 10 speech data and 2, so a stall of about a second is noticed.
+ The default watermarks of `StreamDataRouter` are much larger than the speech data. They are rarely reached and the speech data would never be merged.
+ After the buffer drains, the number is halved on every merged attachment until the speech data is passed through again.
+ So the part overhead is reduced only on the congested network.
+ It is not thread-safe. Use it on the queue of `ASRAgent`.
+ */
+final class ASRAttachmentAggregator {
+    private let maxMergedCount: Int
+    private var mergedCount = 1
+    private var pendingData = Data()
+    private var pendingCount = 0
+    private var isCongested = false
+    
+    init(maxMergedCount: Int) {
+        self.maxMergedCount = maxMergedCount
+    }
+    
+    /**
+     Appends the speech data.
+     
+     - Returns: The speech data to be sent now. `nil` if it is held to be merged with the next ones.
+     */
+    func append(_ speechData: Data) -> Data? {
+        guard 1 < mergedCount || 0 < pendingCount else {
+            return speechData
+        }
+        
+        pendingData.append(speechData)
+        pendingCount += 1
+        guard mergedCount <= pendingCount else { return nil }
+        
+        if isCongested == false {
+            mergedCount = max(mergedCount / 2, 1)
+        }
+        return flush()
+    }
+    
+    /// Takes the held speech data. (ex. at the end of speech)
+    func flush() -> Data? {
+        guard 0 < pendingCount else { return nil }
+        
+        let data = pendingData
+        pendingData = Data()
+        pendingCount = 0
+        return data
+    }
+    
+    func reset() {
+        mergedCount = 1
+        pendingData = Data()
+        pendingCount = 0
+        isCongested = false
+    }
+    
+    func uploadBufferStateChanged(isOverHighWatermark: Bool) {
+        isCongested = isOverHighWatermark
+        if isOverHighWatermark {
+            mergedCount = maxMergedCount
+        }
+        log.debug("upload is \(isOverHighWatermark ? "congested" : "drained"). merged count of speech data: \(mergedCount)")
+    }
+}
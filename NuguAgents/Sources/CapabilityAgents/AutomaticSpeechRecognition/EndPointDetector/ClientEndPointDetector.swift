@@ -35,9 +35,10 @@ class ClientEndPointDetector: EndPointDetectable {
         }
     }
     
-    public init(asrOptions: ASROptions) {
+    public init(asrOptions: ASROptions, isWarmHandleEnabled: Bool = false) {
         self.asrOptions = asrOptions
         engine = TycheEndPointDetectorEngine()
+        engine.isWarmHandleEnabled = isWarmHandleEnabled
         engine.delegate = self
     }
     
@@ -63,6 +64,11 @@ class ClientEndPointDetector: EndPointDetectable {
         engine.putAudioBuffer(buffer: pcmBuffer)
     }
     
+    func putSharedAudioBuffer(buffer: AVAudioPCMBuffer) {
+        // The buffer is shared with the keyword detector. The engine reads it only.
+        engine.putAudioBuffer(buffer: buffer)
+    }
+    
     public func stop() {
         engine.stop()
     }
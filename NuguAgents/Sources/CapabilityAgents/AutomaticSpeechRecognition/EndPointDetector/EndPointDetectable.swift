@@ -28,6 +28,8 @@ protocol EndPointDetectable: AnyObject {
     
     func start()
     func putAudioBuffer(buffer: AVAudioPCMBuffer)
+    /// Puts the buffer without copying. The caller guarantees that it is never modified.
+    func putSharedAudioBuffer(buffer: AVAudioPCMBuffer)
     func stop()
     func handleNotifyResult(_ state: ASRNotifyResult.State)
 }
@@ -39,6 +39,9 @@ class OpusPlayer: MediaPlayable {
     private let player: DataStreamPlayer
     weak var delegate: MediaPlayerDelegate?
     
+    // Incomplete packet of the attachment fragment. It will be completed by the next fragment.
+    private var remainedData = Data()
+    
     init() throws {
         /*
          There's no 22050hz in opus world.
@@ -77,6 +80,7 @@ class OpusPlayer: MediaPlayable {
     }
 
     func stop() {
+        remainedData = Data()
         player.stop()
     }
     
@@ -151,13 +155,39 @@ private extension OpusPlayer {
 }
 
 extension OpusPlayer: MediaOpusStreamDataSource {
+    func appendData(_ segments: SegmentedData, isCompleted: Bool) throws {
+        guard isCompleted else {
+            try appendData(segments.data)
+            return
+        }
+        
+        // The packet can't be completed by the next attachment. So the truncated one is appended as it is and not kept.
+        let packetizedData = remainedData.isEmpty ? segments.data : remainedData + segments.data
+        remainedData = Data()
+        
+        try SktOpusParser.parse(from: packetizedData).forEach { (chunk) in
+            try player.appendData(chunk)
+        }
+    }
+    
     func appendData(_ data: Data) throws {
-        try SktOpusParser.parse(from: data).forEach { (chunk) in
+        let packetizedData = remainedData.isEmpty ? data : remainedData + data
+        let (chunks, parsedIndex) = SktOpusParser.parseCompletedPackets(from: packetizedData)
+        remainedData = packetizedData.subdata(in: parsedIndex..<packetizedData.endIndex)
+        
+        try chunks.forEach { (chunk) in
             try player.appendData(chunk)
         }
     }
     
     func lastDataAppended() throws {
+        if remainedData.isEmpty == false {
+            try SktOpusParser.parse(from: remainedData).forEach { (chunk) in
+                try player.appendData(chunk)
+            }
+            remainedData = Data()
+        }
+        
         try player.lastDataAppended()
     }
 }
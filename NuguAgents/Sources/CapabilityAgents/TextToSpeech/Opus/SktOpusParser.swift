@@ -35,29 +35,50 @@ class SktOpusParser {
      - returns: Opus codec data array
      */
     static func parse(from data: Data) -> [Data] {
-        var packetizedDataStream = data
+        return parse(from: data, allowsIncompletePacket: true).chunks
+    }
+    
+    /**
+     Parse the packets which are received completely.
+     
+     The attachment can be delivered as fragments. So the last packet may be split into the next fragment.
+     
+     - parameter from: Received data from NUGU Server.
+     - returns: Opus codec data array and the index of `data` where the incomplete packet starts.
+     */
+    static func parseCompletedPackets(from data: Data) -> (chunks: [Data], parsedIndex: Int) {
+        return parse(from: data, allowsIncompletePacket: false)
+    }
+}
+
+// MARK: - Private
+
+private extension SktOpusParser {
+    static func parse(from data: Data, allowsIncompletePacket: Bool) -> (chunks: [Data], parsedIndex: Int) {
         var opusDataChunkArray = [Data]()
+        // `data` can be a slice of received data. So don't assume that the index starts from zero.
+        var headerIndex = data.startIndex
         
-        while Self.headerSize < packetizedDataStream.count {
+        while Self.headerSize < data.endIndex - headerIndex {
             // parse header
             // get content size
-            let contentSizeData: Data = packetizedDataStream.subdata(in: 0..<Self.contentSizeIndicatorByteCount)
-            let contentSize = Int(contentSizeData[3]) | (Int(contentSizeData[2]) << 8) | (Int(contentSizeData[1]) << 16) | (Int(contentSizeData[0]) << 24)
+            let contentSize = Int(data[headerIndex + 3]) | (Int(data[headerIndex + 2]) << 8) | (Int(data[headerIndex + 1]) << 16) | (Int(data[headerIndex]) << 24)
             
             // garbage from server. (we don't know the reason why this useless byte is sent by server)
-//            let rangeData = packetizedDataStream.subdata(in: Self.contentSizeIndicatorByteCount..<Self.headerSize)
-//            let range = Int(rangeData[3]) | (Int(rangeData[2]) << 8) | (Int(rangeData[1]) << 16) | (Int(rangeData[0]) << 24)
-//            log.debug("contentSize: \(contentSize), range: \(range), remainedData: \(packetizedDataStream.count)")
-            packetizedDataStream = packetizedDataStream.subdata(in: Self.headerSize..<packetizedDataStream.count)
+//            let rangeIndex = headerIndex + Self.contentSizeIndicatorByteCount
+//            let range = Int(data[rangeIndex + 3]) | (Int(data[rangeIndex + 2]) << 8) | (Int(data[rangeIndex + 1]) << 16) | (Int(data[rangeIndex]) << 24)
+//            log.debug("contentSize: \(contentSize), range: \(range), remainedData: \(data.endIndex - headerIndex)")
+            let payloadIndex = headerIndex + Self.headerSize
+            guard allowsIncompletePacket || contentSize <= data.endIndex - payloadIndex else { break }
             
             // extract payload.
-            let payloadSize = min(contentSize, packetizedDataStream.count)
-            let payload = packetizedDataStream.subdata(in: 0..<payloadSize)
-            packetizedDataStream = packetizedDataStream.subdata(in: payloadSize..<packetizedDataStream.count)
+            let payloadSize = min(contentSize, data.endIndex - payloadIndex)
+            let payload = data.subdata(in: payloadIndex..<(payloadIndex + payloadSize))
+            headerIndex = payloadIndex + payloadSize
             
             opusDataChunkArray.append(payload)
         }
         
-        return opusDataChunkArray
+        return (opusDataChunkArray, headerIndex)
     }
 }
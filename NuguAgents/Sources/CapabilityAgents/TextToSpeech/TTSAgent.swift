@@ -480,7 +480,7 @@ private extension TTSAgent {
             }
             
             #if DEBUG
-            totalAttachmentData.append(attachment.content)
+            attachment.contentSegments.segments.forEach { totalAttachmentData.append($0) }
             if attachment.isEnd {
                 let attachmentFileName = FileManager.default.urls(for: .documentDirectory, in: .userDomainMask)[0]
                     .appendingPathComponent("attachment.data")
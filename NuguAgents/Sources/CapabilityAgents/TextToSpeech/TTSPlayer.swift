@@ -54,7 +54,7 @@ final class TTSPlayer {
         }
         
         do {
-            try dataSource.appendData(attachment.content)
+            try dataSource.appendData(attachment.contentSegments, isCompleted: attachment.isCompleted)
             
             if attachment.isEnd {
                 try dataSource.lastDataAppended()
@@ -49,6 +49,17 @@ public class KeywordDetector: ContextInfoProvidable {
         }
     }
     
+    /// Keeps the engine handle between the sessions. It is disabled by default. See `TycheKeywordDetectorEngine.isWarmHandleEnabled`.
+    public var isWarmHandleEnabled: Bool {
+        get {
+            engine.isWarmHandleEnabled
+        }
+        
+        set {
+            engine.isWarmHandleEnabled = newValue
+        }
+    }
+    
     // Observers
     let observerQueue = DispatchQueue(label: "com.sktelecom.romaine.keensense.tyche_observers")
     var tycheKeywordDetectorStateObserver: Any?
@@ -89,6 +100,11 @@ public class KeywordDetector: ContextInfoProvidable {
         engine.putAudioBuffer(buffer: pcmBuffer)
     }
     
+    /// Put the buffer of `MicInputProvider` without copying. It is shared with the end point detector and never modified.
+    func putSharedAudioBuffer(buffer: AVAudioPCMBuffer) {
+        engine.putAudioBuffer(buffer: buffer)
+    }
+    
     /// Stop keyword detection.
     public func stop() {
         engine.stop()
@@ -164,6 +164,7 @@ public class MicInputProvider {
                         return
                     }
                     
+                    // Consumers share this buffer read only and it is released when the last of them releases it.
                     tapBlock(pcmBuffer, when)
                 }
             }
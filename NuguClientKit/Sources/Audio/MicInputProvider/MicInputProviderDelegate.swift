@@ -24,6 +24,9 @@ import AVFoundation
 /// An delegate to processing audio buffers.
 public protocol MicInputProviderDelegate: AnyObject {
     /// Tells the delegate that the audio buffer has been received.
+    ///
+    /// The buffer is allocated for each call and never modified after it. So `SpeechRecognizerAggregator` shares it with the detectors without copying.
+    /// - Important: The delegate must not modify the buffer either.
     /// - Parameter buffer: The new audio buffer.
     func micInputProviderDidReceive(buffer: AVAudioPCMBuffer)
     
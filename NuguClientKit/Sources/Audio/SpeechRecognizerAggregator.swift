@@ -22,7 +22,7 @@ import Foundation
 import UIKit
 import AVFoundation
 
-import NuguAgents
+@_spi(SharedAudioBuffer) import NuguAgents
 import NuguCore
 import NuguUtils
 
@@ -257,12 +257,17 @@ public extension SpeechRecognizerAggregator {
 
 extension SpeechRecognizerAggregator: MicInputProviderDelegate {
     public func micInputProviderDidReceive(buffer: AVAudioPCMBuffer) {
+        // The buffer of `MicInputProvider` is never modified. So the detectors share it without copying.
         if keywordDetector.state == .active {
-            keywordDetector.putAudioBuffer(buffer: buffer)
+            keywordDetector.putSharedAudioBuffer(buffer: buffer)
         }
         
         if [.listening(), .recognizing].contains(asrAgent.asrState) {
-            asrAgent.putAudioBuffer(buffer: buffer)
+            if let asrAgent = asrAgent as? ASRAgent {
+                asrAgent.putSharedAudioBuffer(buffer: buffer)
+            } else {
+                asrAgent.putAudioBuffer(buffer: buffer)
+            }
         }
     }
     
@@ -418,6 +418,7 @@ public class NuguClient {
     deinit {
         removeStreamDataRouterObservers()
         removeDialogStateObserver()
+        ASRAgent.releaseWarmEndPointDetector()
     }
 }
 
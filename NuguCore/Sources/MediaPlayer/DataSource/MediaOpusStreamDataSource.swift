@@ -20,7 +20,22 @@
 
 import Foundation
 
+import NuguUtils
+
 public protocol MediaOpusStreamDataSource {
     func appendData(_ data: Data) throws
+    func appendData(_ segments: SegmentedData) throws
+    /// - Parameter isCompleted: Whether all the bytes of the attachment are appended. The attachment can be delivered as fragments.
+    func appendData(_ segments: SegmentedData, isCompleted: Bool) throws
     func lastDataAppended() throws
 }
+
+public extension MediaOpusStreamDataSource {
+    func appendData(_ segments: SegmentedData) throws {
+        try appendData(segments.data)
+    }
+    
+    func appendData(_ segments: SegmentedData, isCompleted: Bool) throws {
+        try appendData(segments)
+    }
+}
@@ -25,7 +25,6 @@ import RxSwift
 class EventResponseProcessor: MultiPartProcessable {
     let inputStream: InputStream
     var parser: MultiPartParser?
-    var data = Data()
     let subject = PublishSubject<Data>()
     
     init(inputStream: InputStream) {
@@ -24,34 +24,34 @@ import RxSwift
 
 protocol MultiPartProcessable: AnyObject {
     var parser: MultiPartParser? { get set }
-    var data: Data { get set }
     var subject: PublishSubject<Data> { get }
 }
 
 extension MultiPartProcessable {
-    func parseData() -> [MultiPartParser.Part]? {
+    /**
+     Feed received data to the parser and take parts completed by it.
+     
+     The parser keeps incomplete part by itself. So received data doesn't have to be accumulated.
+     */
+    func parseData(_ data: Data) -> [MultiPartParser.Part]? {
         guard let parser = self.parser else {
             return nil
         }
-            
-        let (parts, size) = parser.separateParts(data: self.data)
-        guard 0 < size else { return nil }
         
         var multiPart = [MultiPartParser.Part]()
-        do {
-            try parts.forEach { (data) in
-                guard 0 < data.count else { return }
-                let part = try parser.parse(data: data)
+        parser.parse(data: data).forEach { result in
+            switch result {
+            case .success(let part):
                 multiPart.append(part)
                 
-                log.debug("\nparsed part header: \(part.header), size: \(data.count)\n"
-                    + "data: \(String(data: part.body, encoding: .utf8) ?? "<<recv data cannot be converted to string>>")")
+                // The body is not logged. Making it contiguous copies the segments. (ex. audio attachment)
+                log.debug("\nparsed part header: \(part.header), size: \(part.body.count)")
+            case .failure(let error):
+                log.error("parser error: \(error)\n"
+                    + "data:\n\(String(data: data, encoding: .ascii) ?? "<<recv data cannot be converted to string>>")")
             }
-        } catch {
-            log.error("parser error: \(error)\n"
-                + "data:\n\(String(data: self.data, encoding: .ascii) ?? "<<recv data cannot be converted to string>>")")
         }
-        self.data = self.data.subdata(in: size..<self.data.count)
+        guard 0 < multiPart.count else { return nil }
         
         return multiPart
     }
@@ -26,15 +26,36 @@ import RxSwift
 
 class NuguApiProvider: NSObject {
     private let requestTimeout: TimeInterval
+    private let sessionConfiguration: URLSessionConfiguration
     private var candidateResourceServers: [String]?
     private var disposeBag = DisposeBag()
     private let processorQueue = DispatchQueue(label: "com.skt.Romaine.nugu_api_provider.processor")
     private lazy var session: URLSession = URLSession(
-        configuration: .ephemeral,
+        configuration: sessionConfiguration,
         delegate: self,
         delegateQueue: nil
     )
     
+    /// Emit the body of attachment part as fragments while it is being received.
+    @Atomic var isAttachmentStreamingEnabled = false
+    
+    /// Advertise that the compressed part body can be decoded. It is off by default because the gateway is not confirmed to support it.
+    @Atomic var isPartCompressionEnabled = false
+    
+    /// Emits the time taken to make the connection to the resource server ready after `policies` is resolved.
+    let connectionReadySubject = PublishSubject<TimeInterval>()
+    
+    /// Records the received downstream traffic if it is set.
+    @Atomic var trafficTraceWriter: TrafficTrace.Writer?
+    
+    /// The last time when the data is sent or received through the session. The traffic of the other sessions (ex. latency probe) is not counted.
+    @Atomic private(set) var lastActivityDate = Date()
+    
+    /// Connect to the server which has the lowest latency instead of the first one of registry.
+    @Atomic var isLatencyProbingEnabled = false
+    private lazy var registrySession = URLSession(configuration: sessionConfiguration)
+    private var reRankDisposable: Disposable?
+    
     @Atomic var loadBalancedUrl: String? {
         didSet {
             log.debug("loadBalancedUrl: \(loadBalancedUrl ?? "nil")")
@@ -78,13 +99,15 @@ class NuguApiProvider: NSObject {
      - Parameter resourceServerUrl: resource server url.
      - Parameter registryServerUrl: server url for client load balancing
      - Parameter options: api options.
+     - Parameter sessionConfiguration: Configuration of the sessions. (ex. `protocolClasses` to serve the requests by a stand-in gateway)
      */
-    init(timeout: TimeInterval = 10.0) {
+    init(timeout: TimeInterval = 10.0, sessionConfiguration: URLSessionConfiguration = .ephemeral) {
         requestTimeout = timeout
+        self.sessionConfiguration = sessionConfiguration
         super.init()
     }
     
-    private let internalPolicies: Single<Policy> = Single<URLRequest>.create { (event) -> Disposable in
+    private lazy var internalPolicies: Single<Policy> = Single<URLRequest>.create { (event) -> Disposable in
         let disposable = Disposables.create()
         
         guard let registryServerAddress = NuguServerInfo.registryServerAddress else {
@@ -115,7 +138,13 @@ class NuguApiProvider: NSObject {
         event(.success(request))
         return disposable
     }
-    .flatMap { $0.rxDataTask(urlSession: URLSession.shared) }
+    .flatMap { [weak self] request -> Single<Data> in
+        guard let registrySession = self?.registrySession else {
+            return Single.error(NetworkError.badRequest)
+        }
+        
+        return request.rxDataTask(urlSession: registrySession)
+    }
     .map { try JSONDecoder().decode(Policy.self, from: $0) }
     .asObservable()
     .share()
@@ -155,6 +184,9 @@ class NuguApiProvider: NSObject {
                     var downstreamRequest = URLRequest(url: downstreamUrl, cachePolicy: .useProtocolCachePolicy, timeoutInterval: Double.infinity)
                     downstreamRequest.httpMethod = NuguApi.directives.method.rawValue
                     downstreamRequest.allHTTPHeaderFields = header
+                    if self.isPartCompressionEnabled {
+                        downstreamRequest.setValue(HTTPConst.acceptPartEncoding, forHTTPHeaderField: HTTPConst.acceptPartEncodingKey)
+                    }
                     task = self.session.dataTask(with: downstreamRequest)
                     task?.resume()
                     log.debug("directive request: \(downstreamRequest)\nheader: \(downstreamRequest.allHTTPHeaderFields?.description ?? "")\n")
@@ -189,10 +221,8 @@ class NuguApiProvider: NSObject {
     }()
     
     private func makePart(with data: Data, processor: MultiPartProcessable) -> Observable<MultiPartParser.Part> {
-        processor.data.append(data)
-        
         var partObserver: Observable<MultiPartParser.Part?> {
-            guard let parts = processor.parseData() else {
+            guard let parts = processor.parseData(data) else {
                 return Observable<MultiPartParser.Part?>.just(nil)
             }
                        
@@ -201,6 +231,14 @@ class NuguApiProvider: NSObject {
         
         return partObserver.compactMap { $0 }
     }
+    
+    private func makeParser(boundary: String) -> MultiPartParser {
+        let bodyStreamingFilter: ((MultiPartHeader) -> Bool)? = isAttachmentStreamingEnabled ? { header in
+            header[.contentType]?.contains(HTTPConst.jsonContentType) == false
+        } : nil
+        
+        return MultiPartParser(boundary: boundary, bodyStreamingFilter: bodyStreamingFilter)
+    }
 }
 
 // MARK: - APIs
@@ -238,6 +276,9 @@ extension NuguApiProvider {
                 streamRequest.httpMethod = NuguApi.events.method.rawValue
                 streamRequest.allHTTPHeaderFields = header
                 streamRequest.allHTTPHeaderFields?[HTTPConst.contentTypeKey] = HTTPConst.eventContentTypePrefix+boundary
+                if self.isPartCompressionEnabled {
+                    streamRequest.setValue(HTTPConst.acceptPartEncoding, forHTTPHeaderField: HTTPConst.acceptPartEncodingKey)
+                }
                 if let httpHeaderFields = httpHeaderFields {
                     streamRequest.allHTTPHeaderFields = streamRequest.allHTTPHeaderFields?.merged(with: httpHeaderFields)
                 }
@@ -269,22 +310,187 @@ extension NuguApiProvider {
         }
     }
     
+    /**
+     Cancel the upload task which reads the input stream.
+     */
+    func cancelEvents(inputStream: InputStream) {
+        eventResponseProcessors.first { $0.value.inputStream === inputStream }?.key.cancel()
+    }
+    
+    /**
+     Replay the trace recorded by `trafficTraceWriter` as if the streams are received.
+     
+     Chunks are parsed in the same way as the received data. The parts of every stream are emitted in the order of records.
+     - Parameter url: The trace file.
+     - Parameter isRealTime: Emit the chunks at the original timing. Otherwise emit them as fast as possible.
+     */
+    func replay(trace url: URL, isRealTime: Bool) -> Observable<MultiPartParser.Part> {
+        return Observable.create { [weak self] observer in
+            let disposable = BooleanDisposable()
+            
+            DispatchQueue.global(qos: .utility).async {
+                do {
+                    let records = try TrafficTrace.records(at: url)
+                    let startTime = DispatchTime.now().uptimeNanoseconds
+                    var processors = [Int: ServerSentEventProcessor]()
+                    
+                    for record in records {
+                        guard let self = self, disposable.isDisposed == false else { return }
+                        
+                        if isRealTime {
+                            let elapsedTime = DispatchTime.now().uptimeNanoseconds - startTime
+                            if elapsedTime < record.timestamp {
+                                Thread.sleep(forTimeInterval: TimeInterval(record.timestamp - elapsedTime) / 1_000_000_000)
+                            }
+                        }
+                        
+                        switch record.kind {
+                        case .response:
+                            let processor = ServerSentEventProcessor()
+                            processor.parser = self.makeParser(boundary: String(decoding: record.bytes, as: UTF8.self))
+                            processors[record.stream] = processor
+                        case .chunk:
+                            // Parsed in the same way as the received data.
+                            guard let processor = processors[record.stream] else { continue }
+                            
+                            _ = self.makePart(with: record.bytes, processor: processor)
+                                .subscribe(onNext: { observer.onNext($0) })
+                        }
+                    }
+                    
+                    observer.onCompleted()
+                } catch {
+                    observer.onError(error)
+                }
+            }
+            
+            return disposable
+        }
+    }
+    
     /**
      Find available device gateway (resource server)
     */
     var policies: Single<Policy> {
         return internalPolicies
+            .flatMap { [weak self] networkPolicy -> Single<Policy> in
+                guard let self = self, self.isLatencyProbingEnabled else { return Single.just(networkPolicy) }
+                
+                // Connect to the server responded first. The ranking is finished in the background and reorders the fallback servers.
+                let ranking = self.rankServers(networkPolicy.serverPolicies).share(replay: 1)
+                ranking
+                    .skip(1)
+                    .subscribe(onNext: { [weak self] rankedPolicies in
+                        self?.updateFallbackServers(rankedPolicies)
+                    })
+                    .disposed(by: self.disposeBag)
+                
+                return ranking
+                    .take(1)
+                    .asSingle()
+                    .map { Policy(serverPolicies: $0, healthCheckPolicy: networkPolicy.healthCheckPolicy) }
+            }
             .do { [weak self] networkPolicy in
                 log.debug("Server initiated directive policies: \(networkPolicy.serverPolicies)")
                 self?.serverPolicies = networkPolicy.serverPolicies
                 
                 if let currentPolicy = self?.serverPolicies.removeFirst() {
-                    self?.loadBalancedUrl = "https://\(currentPolicy.hostname):\(currentPolicy.port)"
+                    let loadBalancedUrl = "https://\(currentPolicy.hostname):\(currentPolicy.port)"
+                    self?.loadBalancedUrl = loadBalancedUrl
                     self?.cslbState = .activated
+                    self?.warmUpConnection(baseUrl: loadBalancedUrl)
                 }
+                
+                self?.startReRanking(networkPolicy.serverPolicies)
             }
     }
     
+    /**
+     Rank the servers again in the background periodically.
+     
+     The current connection is kept and only the order of remaining fallback servers is updated.
+     */
+    private func startReRanking(_ serverPolicies: [Policy.ServerPolicy]) {
+        reRankDisposable?.dispose()
+        guard isLatencyProbingEnabled, 1 < serverPolicies.count else { return }
+        
+        reRankDisposable = Observable<Int>.interval(Const.reRankInterval, scheduler: ConcurrentDispatchQueueScheduler(qos: .utility))
+            .flatMapLatest { [weak self] _ -> Observable<[Policy.ServerPolicy]> in
+                guard let self = self else { return Observable.empty() }
+                
+                return self.rankServers(serverPolicies).takeLast(1)
+            }
+            .subscribe(onNext: { [weak self] rankedPolicies in
+                self?.updateFallbackServers(rankedPolicies)
+            })
+    }
+    
+    /// Keep the fallback servers only and follow the order of `rankedPolicies`.
+    private func updateFallbackServers(_ rankedPolicies: [Policy.ServerPolicy]) {
+        _serverPolicies.mutate { fallbackPolicies in
+            let fallbackHostnames = Set(fallbackPolicies.map { $0.hostname })
+            fallbackPolicies = rankedPolicies.filter { fallbackHostnames.contains($0.hostname) }
+        }
+    }
+    
+    /**
+     Rank the servers on a new session.
+     
+     The connections of a session are not shared with the others and invalidated after the ranking.
+     So every ranking measures the connect time of every server, and the connections warmed by the previous ranking don't hide it.
+     */
+    private func rankServers(_ serverPolicies: [Policy.ServerPolicy]) -> Observable<[Policy.ServerPolicy]> {
+        return Observable.deferred { [weak self] in
+            guard let self = self else { return Observable.error(NetworkError.unknown) }
+            
+            let probeSession = URLSession(configuration: self.sessionConfiguration)
+            let serverLatencyRanker = ServerLatencyRanker(timeout: Const.probeTimeout) { [weak self] serverPolicy in
+                guard let self = self else { return Single.error(NetworkError.unknown) }
+                
+                return self.probeLatency(of: serverPolicy, urlSession: probeSession)
+            }
+            
+            return serverLatencyRanker.rank(serverPolicies)
+                .do(onDispose: {
+                    probeSession.invalidateAndCancel()
+                })
+        }
+    }
+    
+    private func probeLatency(of serverPolicy: Policy.ServerPolicy, urlSession: URLSession) -> Single<TimeInterval> {
+        let baseUrl = "https://\(serverPolicy.hostname):\(serverPolicy.port)"
+        
+        return Single.deferred { [weak self] in
+            guard let self = self else { return Single.error(NetworkError.unknown) }
+            
+            let startTime = Date()
+            return self.ping(baseUrl: baseUrl, urlSession: urlSession)
+                .andThen(Single.deferred { Single.just(Date().timeIntervalSince(startTime)) })
+        }
+    }
+    
+    /**
+     Open the connection to the resource server on the session used by `events`.
+     
+     TLS and HTTP/2 handshake is done before the first event is sent.
+     And the connection is kept alive by the session while the server side event stream or ping uses it.
+     */
+    private func warmUpConnection(baseUrl: String) {
+        let startTime = Date()
+        
+        ping(baseUrl: baseUrl, urlSession: session)
+            .subscribe(onCompleted: { [weak self] in
+                self?.lastActivityDate = Date()
+                
+                let timeToReady = Date().timeIntervalSince(startTime)
+                log.debug("connection to \(baseUrl) is ready in \(timeToReady) sec")
+                self?.connectionReadySubject.onNext(timeToReady)
+            }, onError: { error in
+                log.error("warming up the connection to \(baseUrl) is failed: \(error)")
+            })
+            .disposed(by: disposeBag)
+    }
+    
     private func retryDirective(observer: Observable<Error>) -> Observable<Int> {
         return observer
             .enumerated()
@@ -342,12 +548,23 @@ extension NuguApiProvider {
      Send ping data to keep stream of server side event
      */
     var ping: Completable {
-        guard let baseUrl = resourceServerAddress,
-              let pingUrl = URL(string: NuguApi.ping.uri(baseUrl: baseUrl)) else {
+        guard let baseUrl = resourceServerAddress else {
             log.error("no resource server url")
             return Completable.error(NetworkError.noSuitableResourceServer)
         }
         
+        return ping(baseUrl: baseUrl, urlSession: session)
+            .do(onCompleted: { [weak self] in
+                self?.lastActivityDate = Date()
+            })
+    }
+    
+    private func ping(baseUrl: String, urlSession: URLSession) -> Completable {
+        guard let pingUrl = URL(string: NuguApi.ping.uri(baseUrl: baseUrl)) else {
+            log.error("invailid url: \(NuguApi.ping.uri(baseUrl: baseUrl))")
+            return Completable.error(NetworkError.noSuitableResourceServer)
+        }
+        
         guard let header = NuguApi.ping.header else {
             return Completable.error(NetworkError.authError)
         }
@@ -356,7 +573,7 @@ extension NuguApiProvider {
         request.httpMethod = NuguApi.ping.method.rawValue
         request.allHTTPHeaderFields = header
         
-        return request.rxDataTask(urlSession: session)
+        return request.rxDataTask(urlSession: urlSession)
             .asCompletable()
     }
 }
@@ -393,7 +610,8 @@ extension NuguApiProvider: URLSessionDataDelegate, StreamDelegate {
                     return
             }
             
-            processor.parser = MultiPartParser(boundary: String(boundary))
+            trafficTraceWriter?.record(.response, stream: dataTask.taskIdentifier, bytes: Data(boundary.utf8))
+            processor.parser = makeParser(boundary: String(boundary))
             completionHandler(.allow)
             
         case .unauthorized:
@@ -421,7 +639,13 @@ extension NuguApiProvider: URLSessionDataDelegate, StreamDelegate {
         completionHandler(processor.inputStream)
     }
     
+    func urlSession(_ session: URLSession, task: URLSessionTask, didSendBodyData bytesSent: Int64, totalBytesSent: Int64, totalBytesExpectedToSend: Int64) {
+        lastActivityDate = Date()
+    }
+    
     func urlSession(_ session: URLSession, dataTask: URLSessionDataTask, didReceive data: Data) {
+        lastActivityDate = Date()
+        trafficTraceWriter?.record(.chunk, stream: dataTask.taskIdentifier, bytes: data)
         (eventResponseProcessors[dataTask]?.subject ?? serverSentEventProcessor?.subject)?.onNext(data)
     }
     
@@ -442,3 +666,12 @@ extension NuguApiProvider: URLSessionDataDelegate, StreamDelegate {
         processor?.subject.onCompleted()
     }
 }
+
+// MARK: - Const
+
+private extension NuguApiProvider {
+    enum Const {
+        static let probeTimeout = RxTimeInterval.seconds(3)
+        static let reRankInterval = RxTimeInterval.seconds(600)
+    }
+}
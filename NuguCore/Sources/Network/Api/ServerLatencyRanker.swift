@@ -0,0 +1,112 @@
+//
+//  ServerLatencyRanker.swift
+//  NuguCore
+//
+//  Created by agent on 2026/10/16.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+import RxSwift
+
+/**
+ Ranks the resource servers by latency.
+ 
+ Every server is probed concurrently and sorted by the measured latency.
+ The server which fails or times out is placed after the others in the registry order.
+ The probe is injected, so the ranking can be driven without the real servers.
+ */
+class ServerLatencyRanker {
+    typealias Probe = (Policy.ServerPolicy) -> Single<TimeInterval>
+    
+    private let probe: Probe
+    private let timeout: RxTimeInterval
+    private let probeScheduler = ConcurrentDispatchQueueScheduler(qos: .utility)
+    
+    /**
+     - Parameter timeout: The server which doesn't respond in it is regarded as failed.
+     - Parameter probe: Measures the latency (ex. connect time or ping RTT) of the server.
+     */
+    init(timeout: RxTimeInterval, probe: @escaping Probe) {
+        self.timeout = timeout
+        self.probe = probe
+    }
+    
+    /**
+     Emits the ranking twice at most.
+     
+     The first one is emitted as soon as a server responds. The server is placed first and the others are not ranked yet.
+     So the connection doesn't wait for the slowest server. The last one is emitted when every server is probed.
+     If no server responds, only the registry order is emitted after the timeout.
+     */
+    func rank(_ serverPolicies: [Policy.ServerPolicy]) -> Observable<[Policy.ServerPolicy]> {
+        guard 1 < serverPolicies.count else {
+            return Observable.just(serverPolicies)
+        }
+        
+        let probes = serverPolicies.enumerated().map { (index, serverPolicy) -> Observable<ProbeResult> in
+            return probe(serverPolicy)
+                .timeout(timeout, scheduler: probeScheduler)
+                .map { ProbeResult(index: index, latency: $0) }
+                .catchAndReturn(ProbeResult(index: index, latency: nil))
+                .asObservable()
+        }
+        
+        return Observable.merge(probes)
+            .scan(into: [ProbeResult]()) { (results, result) in
+                results.append(result)
+            }
+            .filter { (results) -> Bool in
+                let isFirstResponse = results.last?.latency != nil && results.filter { $0.latency != nil }.count == 1
+                return isFirstResponse || results.count == serverPolicies.count
+            }
+            .map { (results) -> [Policy.ServerPolicy] in
+                let probedIndices = Set(results.map { $0.index })
+                let pendingResults = serverPolicies.indices
+                    .filter { probedIndices.contains($0) == false }
+                    .map { ProbeResult(index: $0, latency: nil) }
+                let rankedResults = (results + pendingResults).sorted(by: <)
+                let rankedPolicies = rankedResults.map { serverPolicies[$0.index] }
+                log.debug("ranked servers: \(rankedPolicies.map { $0.hostname }), latencies: \(rankedResults.map { $0.latency }), probed: \(results.count)/\(serverPolicies.count)")
+                
+                return rankedPolicies
+            }
+    }
+}
+
+// MARK: - ProbeResult
+
+private extension ServerLatencyRanker {
+    struct ProbeResult: Comparable {
+        /// The index in registry order.
+        let index: Int
+        /// `nil` if the probe is failed.
+        let latency: TimeInterval?
+        
+        static func < (lhs: ProbeResult, rhs: ProbeResult) -> Bool {
+            switch (lhs.latency, rhs.latency) {
+            case let (lhsLatency?, rhsLatency?) where lhsLatency != rhsLatency:
+                return lhsLatency < rhsLatency
+            case (.some, .none):
+                return true
+            case (.none, .some):
+                return false
+            default:
+                return lhs.index < rhs.index
+            }
+        }
+    }
+}
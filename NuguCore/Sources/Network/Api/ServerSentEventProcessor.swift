@@ -24,6 +24,5 @@ import RxSwift
 
 class ServerSentEventProcessor: MultiPartProcessable {
     var parser: MultiPartParser?
-    var data = Data()
     let subject = PublishSubject<Data>()
 }
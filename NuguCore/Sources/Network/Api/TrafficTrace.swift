@@ -0,0 +1,187 @@
+//
+//  TrafficTrace.swift
+//  NuguCore
+//
+//  Created by agent on 2026/10/16.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/**
+ Binary trace of the downstream multipart traffic.
+ 
+ The trace starts with the magic and version, followed by records.
+ Each record is `kind(UInt8) | stream(UInt32) | timestamp(UInt64, nanoseconds from the start) | length(UInt32) | bytes` in little endian.
+ The bytes of the response record is the multipart boundary, and the bytes of the chunk record is the received data as it is.
+ */
+enum TrafficTrace {
+    enum Kind: UInt8 {
+        /// The response of the stream is received. The boundary of multipart follows.
+        case response = 0
+        /// A chunk of the stream is received.
+        case chunk = 1
+    }
+    
+    struct Record {
+        let kind: Kind
+        let stream: Int
+        /// Nanoseconds from the start of the capture.
+        let timestamp: UInt64
+        let bytes: Data
+    }
+}
+
+// MARK: - Writer
+
+extension TrafficTrace {
+    /// Appends records to the trace file. Records are written in the order of arrival on its own queue.
+    class Writer {
+        private let fileHandle: FileHandle
+        private let startTime = DispatchTime.now().uptimeNanoseconds
+        private let writeQueue = DispatchQueue(label: "com.sktelecom.romaine.core.traffic_trace_writer")
+        // Accessed on `writeQueue` only.
+        private var isClosed = false
+        
+        init(url: URL) throws {
+            guard FileManager.default.createFile(atPath: url.path, contents: Const.magic + [Const.version]) else {
+                throw NetworkError.invalidParameter
+            }
+            
+            fileHandle = try FileHandle(forWritingTo: url)
+            fileHandle.seekToEndOfFile()
+        }
+        
+        func record(_ kind: Kind, stream: Int, bytes: Data) {
+            let timestamp = DispatchTime.now().uptimeNanoseconds - startTime
+            
+            writeQueue.async { [weak self] in
+                guard let self = self, self.isClosed == false else { return }
+                
+                var record = Data(capacity: Const.recordHeaderSize + bytes.count)
+                record.append(kind.rawValue)
+                record.appendLittleEndian(UInt32(truncatingIfNeeded: stream))
+                record.appendLittleEndian(timestamp)
+                record.appendLittleEndian(UInt32(bytes.count))
+                record.append(bytes)
+                
+                do {
+                    try self.write(record)
+                } catch {
+                    // ex. The disk is full. The trace is stopped instead of raising the exception again.
+                    log.error("traffic trace is stopped. error: \(error)")
+                    self.isClosed = true
+                    self.fileHandle.closeFile()
+                }
+            }
+        }
+        
+        func close() {
+            writeQueue.sync {
+                guard isClosed == false else { return }
+                
+                isClosed = true
+                fileHandle.closeFile()
+            }
+        }
+        
+        /// `FileHandle.write(_:)` raises the Objective-C exception on failure, which cannot be caught in Swift.
+        private func write(_ data: Data) throws {
+            if #available(iOS 13.4, watchOS 6.2, *) {
+                try fileHandle.write(contentsOf: data)
+                return
+            }
+            
+            let fileDescriptor = fileHandle.fileDescriptor
+            try data.withUnsafeBytes { (buffer: UnsafeRawBufferPointer) in
+                guard let baseAddress = buffer.baseAddress else { return }
+                
+                var offset = 0
+                while offset < buffer.count {
+                    let writtenCount = Darwin.write(fileDescriptor, baseAddress + offset, buffer.count - offset)
+                    guard 0 <= writtenCount else {
+                        throw POSIXError(POSIXErrorCode(rawValue: errno) ?? .EIO)
+                    }
+                    
+                    offset += writtenCount
+                }
+            }
+        }
+    }
+}
+
+// MARK: - Reader
+
+extension TrafficTrace {
+    /// Reads all records of the trace file. The file is mapped, and the bytes of records are slices of it.
+    static func records(at url: URL) throws -> [Record] {
+        let data = try Data(contentsOf: url, options: .alwaysMapped)
+        guard data.starts(with: Const.magic + [Const.version]) else {
+            throw NetworkError.invalidMessageReceived
+        }
+        
+        var records = [Record]()
+        var index = data.startIndex + Const.magic.count + 1
+        while index < data.endIndex {
+            guard Const.recordHeaderSize <= data.endIndex - index,
+                let kind = Kind(rawValue: data[index]) else {
+                    throw NetworkError.invalidMessageReceived
+            }
+            
+            let stream = data.readLittleEndian(UInt32.self, at: index + 1)
+            let timestamp = data.readLittleEndian(UInt64.self, at: index + 5)
+            let length = Int(data.readLittleEndian(UInt32.self, at: index + 13))
+            index += Const.recordHeaderSize
+            
+            guard length <= data.endIndex - index else {
+                throw NetworkError.invalidMessageReceived
+            }
+            
+            records.append(Record(kind: kind, stream: Int(stream), timestamp: timestamp, bytes: data[index..<(index + length)]))
+            index += length
+        }
+        
+        return records
+    }
+}
+
+// MARK: - Const
+
+private extension TrafficTrace {
+    enum Const {
+        static let magic = Data("NGTR".utf8)
+        static let version: UInt8 = 1
+        /// kind(1) + stream(4) + timestamp(8) + length(4)
+        static let recordHeaderSize = 17
+    }
+}
+
+// MARK: - Data + little endian
+
+private extension Data {
+    mutating func appendLittleEndian<T: FixedWidthInteger>(_ value: T) {
+        var littleEndian = value.littleEndian
+        Swift.withUnsafeBytes(of: &littleEndian) { append(contentsOf: $0) }
+    }
+    
+    func readLittleEndian<T: FixedWidthInteger>(_ type: T.Type, at index: Index) -> T {
+        var value = T.zero
+        Swift.withUnsafeMutableBytes(of: &value) { buffer in
+            _ = copyBytes(to: buffer, from: index..<(index + MemoryLayout<T>.size))
+        }
+        
+        return T(littleEndian: value)
+    }
+}
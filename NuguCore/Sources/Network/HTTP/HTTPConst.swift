@@ -52,6 +52,11 @@ enum HTTPConst {
     static let colon = ":".data(using: .utf8)![0]
     
     static let contentTypeKey = "Content-Type"
+    static let jsonContentType = "application/json"
     static let eventContentTypePrefix = "multipart/form-data; boundary="
     static let boundaryPrefix = "nugusdk.boundary."
+    /// Advertises the `Content-Encoding` of part which can be decoded. It is not the one of whole response handled by `URLSession`.
+    /// It is not a standard header and not verified against the gateway. It is sent only if `isPartCompressionEnabled` is set.
+    static let acceptPartEncodingKey = "Accept-Part-Encoding"
+    static let acceptPartEncoding = "gzip, deflate"
 }
@@ -0,0 +1,205 @@
+//
+//  ByteSearcher.swift
+//  NuguCore
+//
+//  Created by agent on 2026/10/16.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/**
+ Search kernel for the delimiters of multipart stream. (boundary, CRLF and so on)
+ 
+ The needle is encoded once and the Boyer-Moore-Horspool skip table is built on initialization.
+ Single byte search is done by `memchr` which is vectorized by libc of each platform.
+ Every path is plain Swift, so it works on any platform without SIMD intrinsics.
+ The platform without Darwin or Glibc uses the scalar loops instead of `memchr` and `memcmp`.
+ */
+struct ByteSearcher {
+    let needle: [UInt8]
+    private let skipTable: [Int]
+    private let failureTable: [Int]
+    
+    init(_ needle: [UInt8]) {
+        self.needle = needle
+        
+        var skipTable = [Int](repeating: max(needle.count, 1), count: 256)
+        for (index, byte) in needle.dropLast().enumerated() {
+            skipTable[Int(byte)] = needle.count - 1 - index
+        }
+        self.skipTable = skipTable
+        
+        var failureTable = [Int](repeating: 0, count: needle.count)
+        var matched = 0
+        for index in needle.indices.dropFirst() {
+            while 0 < matched, needle[index] != needle[matched] {
+                matched = failureTable[matched - 1]
+            }
+            
+            if needle[index] == needle[matched] {
+                matched += 1
+            }
+            failureTable[index] = matched
+        }
+        self.failureTable = failureTable
+    }
+    
+    init(_ needle: String) {
+        self.init(Array(needle.utf8))
+    }
+}
+
+// MARK: - Search
+
+extension ByteSearcher {
+    /// Result of the streaming search.
+    enum Match: Equatable {
+        /// Needle is found and it ends right before `endIndex`.
+        case found(endIndex: Int)
+        /// Needle is not found. `matched` bytes at the end of data are the prefix of needle.
+        case partial(matched: Int)
+    }
+    
+    /**
+     Search the needle which may be split across consecutive data.
+     
+     - Parameter bytes: Data to search.
+     - Parameter startIndex: Index of `bytes` to start.
+     - Parameter matched: Length of needle prefix matched at the end of previous data.
+     */
+    func match(in bytes: UnsafeBufferPointer<UInt8>, from startIndex: Int, matched: Int) -> Match {
+        var index = startIndex
+        var matched = matched
+        
+        // Resume the match carried over from previous data.
+        while 0 < matched, index < bytes.count {
+            matched = advance(matched: matched, with: bytes[index])
+            index += 1
+            
+            if matched == needle.count {
+                return .found(endIndex: index)
+            }
+        }
+        
+        guard 0 == matched else {
+            return .partial(matched: matched)
+        }
+        
+        if let foundIndex = firstIndex(in: bytes, from: index) {
+            return .found(endIndex: foundIndex + needle.count)
+        }
+        
+        return .partial(matched: suffixMatchLength(in: bytes, from: index))
+    }
+    
+    /// Returns the start index of the first needle in `bytes[startIndex...]`
+    func firstIndex(in bytes: UnsafeBufferPointer<UInt8>, from startIndex: Int = 0) -> Int? {
+        guard let baseAddress = bytes.baseAddress, 0 < needle.count, needle.count <= bytes.count - startIndex else {
+            return nil
+        }
+        
+        if needle.count == 1 {
+            return ByteSearcher.firstIndex(of: needle[0], in: bytes, from: startIndex)
+        }
+        
+        return needle.withUnsafeBufferPointer { needleBuffer -> Int? in
+            let lastIndex = needle.count - 1
+            let lastByte = needleBuffer[lastIndex]
+            var index = startIndex
+            
+            while index + lastIndex < bytes.count {
+                let byte = bytes[index + lastIndex]
+                if byte == lastByte, ByteSearcher.equals(baseAddress + index, needleBuffer.baseAddress!, count: lastIndex) {
+                    return index
+                }
+                
+                index += skipTable[Int(byte)]
+            }
+            
+            return nil
+        }
+    }
+    
+    /// Returns the index of the first `byte` in `bytes[startIndex...]`
+    static func firstIndex(of byte: UInt8, in bytes: UnsafeBufferPointer<UInt8>, from startIndex: Int = 0) -> Int? {
+        #if canImport(Darwin) || canImport(Glibc)
+        guard let baseAddress = bytes.baseAddress, startIndex < bytes.count,
+              let found = memchr(baseAddress + startIndex, Int32(byte), bytes.count - startIndex) else {
+            return nil
+        }
+        
+        return baseAddress.distance(to: found.assumingMemoryBound(to: UInt8.self))
+        #else
+        return scalarFirstIndex(of: byte, in: bytes, from: startIndex)
+        #endif
+    }
+    
+    /// Portable fallback of `firstIndex(of:in:from:)`. It is the reference of the tests and the benchmark too.
+    static func scalarFirstIndex(of byte: UInt8, in bytes: UnsafeBufferPointer<UInt8>, from startIndex: Int = 0) -> Int? {
+        var index = startIndex
+        while index < bytes.count {
+            if bytes[index] == byte {
+                return index
+            }
+            
+            index += 1
+        }
+        
+        return nil
+    }
+}
+
+// MARK: - Private
+
+private extension ByteSearcher {
+    func advance(matched: Int, with byte: UInt8) -> Int {
+        var matched = matched
+        while 0 < matched, needle[matched] != byte {
+            matched = failureTable[matched - 1]
+        }
+        
+        return needle[matched] == byte ? matched + 1 : matched
+    }
+    
+    /// Length of the longest suffix of `bytes[startIndex...]` which is also a prefix of needle.
+    func suffixMatchLength(in bytes: UnsafeBufferPointer<UInt8>, from startIndex: Int) -> Int {
+        guard let baseAddress = bytes.baseAddress else { return 0 }
+        
+        let maxLength = min(needle.count - 1, bytes.count - startIndex)
+        guard 0 < maxLength else { return 0 }
+        
+        return needle.withUnsafeBufferPointer { needleBuffer -> Int in
+            for length in stride(from: maxLength, to: 0, by: -1)
+            where ByteSearcher.equals(baseAddress + bytes.count - length, needleBuffer.baseAddress!, count: length) {
+                return length
+            }
+            
+            return 0
+        }
+    }
+    
+    static func equals(_ lhs: UnsafePointer<UInt8>, _ rhs: UnsafePointer<UInt8>, count: Int) -> Bool {
+        #if canImport(Darwin) || canImport(Glibc)
+        return memcmp(lhs, rhs, count) == 0
+        #else
+        for index in 0..<count where lhs[index] != rhs[index] {
+            return false
+        }
+        
+        return true
+        #endif
+    }
+}
@@ -0,0 +1,218 @@
+//
+//  MultiPartHeader.swift
+//  NuguCore
+//
+//  Created by agent on 2026/10/16.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/**
+ Header of multipart part.
+ 
+ Field names are matched case-insensitively against the known NUGU header fields straight from the received bytes.
+ Values are kept as byte ranges of the header bytes and decoded only when they are requested.
+ Unknown fields are kept in the overflow map.
+ */
+struct MultiPartHeader {
+    private let data: Data
+    private var knownFieldRanges: [Range<Int>?]
+    private var unknownFieldRanges = [String: Range<Int>]()
+    
+    init() {
+        data = Data()
+        knownFieldRanges = [Range<Int>?](repeating: nil, count: Field.allCases.count)
+    }
+    
+    /**
+     - Parameter data: Header lines. Every line including the last one must be terminated by CRLF.
+     */
+    init(data: Data) throws {
+        var knownFieldRanges = [Range<Int>?](repeating: nil, count: Field.allCases.count)
+        var unknownFieldRanges = [String: Range<Int>]()
+        
+        try data.withUnsafeBytes { (rawBuffer: UnsafeRawBufferPointer) in
+            let bytes = rawBuffer.bindMemory(to: UInt8.self)
+            var lineIndex = 0
+            
+            while let lineEndIndex = Const.crlfSearcher.firstIndex(in: bytes, from: lineIndex) {
+                defer { lineIndex = lineEndIndex + 2 }
+                guard lineIndex < lineEndIndex else { continue }
+                
+                guard let colonIndex = ByteSearcher.firstIndex(of: HTTPConst.colon, in: bytes, from: lineIndex),
+                      colonIndex < lineEndIndex else {
+                    throw NetworkError.invalidMessageReceived
+                }
+                
+                var valueIndex = colonIndex + 1
+                while valueIndex < lineEndIndex, bytes[valueIndex] == Const.space {
+                    valueIndex += 1
+                }
+                
+                let nameBytes = UnsafeBufferPointer(rebasing: bytes[lineIndex..<colonIndex])
+                if let field = Field(nameBytes) {
+                    knownFieldRanges[field.rawValue] = valueIndex..<lineEndIndex
+                    continue
+                }
+                
+                guard let name = String(bytes: nameBytes, encoding: .utf8) else {
+                    throw NetworkError.invalidMessageReceived
+                }
+                unknownFieldRanges[name.lowercased()] = valueIndex..<lineEndIndex
+            }
+        }
+        
+        self.data = data
+        self.knownFieldRanges = knownFieldRanges
+        self.unknownFieldRanges = unknownFieldRanges
+    }
+}
+
+// MARK: - Field
+
+extension MultiPartHeader {
+    /// Known header fields of NUGU multipart message.
+    enum Field: Int, CaseIterable {
+        case contentType
+        case contentLength
+        case contentDisposition
+        case contentEncoding
+        case namespace
+        case name
+        case dialogRequestId
+        case messageId
+        case version
+        case filename
+        case parentMessageId
+        case referrerDialogRequestId
+        
+        var fieldName: String {
+            switch self {
+            case .contentType: return "Content-Type"
+            case .contentLength: return "Content-Length"
+            case .contentDisposition: return "Content-Disposition"
+            case .contentEncoding: return "Content-Encoding"
+            case .namespace: return "Namespace"
+            case .name: return "Name"
+            case .dialogRequestId: return "Dialog-Request-Id"
+            case .messageId: return "Message-Id"
+            case .version: return "Version"
+            case .filename: return "Filename"
+            case .parentMessageId: return "Parent-Message-Id"
+            case .referrerDialogRequestId: return "Referrer-Dialog-Request-Id"
+            }
+        }
+        
+        /// Lowercased bytes of the field names. The index is `rawValue`.
+        private static let lowercasedNames: [[UInt8]] = allCases.map { Array($0.fieldName.lowercased().utf8) }
+        
+        /// The length is compared first and the bytes are compared in place. Nothing is allocated for the header line.
+        init?(_ nameBytes: UnsafeBufferPointer<UInt8>) {
+            for (rawValue, lowercasedName) in Field.lowercasedNames.enumerated() where lowercasedName.count == nameBytes.count {
+                var index = 0
+                while index < nameBytes.count, MultiPartHeader.lowercased(nameBytes[index]) == lowercasedName[index] {
+                    index += 1
+                }
+                
+                if index == nameBytes.count, let field = Field(rawValue: rawValue) {
+                    self = field
+                    return
+                }
+            }
+            
+            return nil
+        }
+        
+        init?(_ name: String) {
+            var name = name
+            guard let field = name.withUTF8({ Field($0) }) else { return nil }
+            
+            self = field
+        }
+    }
+}
+
+// MARK: - Value
+
+extension MultiPartHeader {
+    /// Decode the value of known field.
+    subscript(field: Field) -> String? {
+        guard let range = knownFieldRanges[field.rawValue] else { return nil }
+        
+        return string(in: range)
+    }
+    
+    /// Decode the value of any field. The name is matched case-insensitively.
+    subscript(name: String) -> String? {
+        if let field = Field(name) {
+            return self[field]
+        }
+        
+        guard let range = unknownFieldRanges[name.lowercased()] else { return nil }
+        
+        return string(in: range)
+    }
+    
+    /// Parse the decimal value of known field without decoding it to `String`.
+    func integer(_ field: Field) -> Int? {
+        guard let range = knownFieldRanges[field.rawValue], 0 < range.count else { return nil }
+        
+        var value = 0
+        for index in range {
+            let digit = Int(data[data.startIndex + index]) - Int(Const.zero)
+            guard 0...9 ~= digit else { return nil }
+            
+            let (multiplied, multiplyOverflow) = value.multipliedReportingOverflow(by: 10)
+            let (added, addOverflow) = multiplied.addingReportingOverflow(digit)
+            guard multiplyOverflow == false, addOverflow == false else { return nil }
+            
+            value = added
+        }
+        
+        return value
+    }
+}
+
+// MARK: - CustomStringConvertible
+
+extension MultiPartHeader: CustomStringConvertible {
+    var description: String {
+        let knownFields = Field.allCases.compactMap { field in self[field].map { "\(field.fieldName): \($0)" } }
+        let unknownFields = unknownFieldRanges.compactMap { name, range in string(in: range).map { "\(name): \($0)" } }
+        
+        return (knownFields + unknownFields).description
+    }
+}
+
+// MARK: - Private
+
+private extension MultiPartHeader {
+    enum Const {
+        static let crlfSearcher = ByteSearcher(HTTPConst.crlf)
+        static let space = " ".data(using: .utf8)![0]
+        static let zero = "0".data(using: .utf8)![0]
+        static let upperA = "A".data(using: .utf8)![0]
+        static let upperZ = "Z".data(using: .utf8)![0]
+    }
+    
+    static func lowercased(_ byte: UInt8) -> UInt8 {
+        return (Const.upperA...Const.upperZ) ~= byte ? byte | 0x20 : byte
+    }
+    
+    func string(in range: Range<Int>) -> String? {
+        return String(data: data[(data.startIndex + range.lowerBound)..<(data.startIndex + range.upperBound)], encoding: .utf8)
+    }
+}
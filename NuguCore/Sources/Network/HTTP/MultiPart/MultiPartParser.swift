@@ -20,90 +20,234 @@
 
 import Foundation
 
+import NuguUtils
+
+/**
+ Incremental multipart parser.
+ 
+ Received chunks are fed in order and every byte is examined only once.
+ Part body is composed of the slices of received chunks, so it is not copied in the parser.
+ The parse state (boundary match progress, header phase and remaining body bytes) is kept between chunks.
+ 
+ If `bodyStreamingFilter` accepts the part header, the body received so far is emitted as a fragment at the end of every data.
+ And the last fragment is marked by `Part.isCompleted`.
+ 
+ The body of the part which has `Content-Encoding` (gzip or deflate) is inflated as it is received.
+ */
 class MultiPartParser {
     let boundary: String
+    private let boundarySearcher: ByteSearcher
+    private let bodyStreamingFilter: ((MultiPartHeader) -> Bool)?
+    
+    private var state: State = .boundary(matched: 0)
+    private var headerData = Data()
+    private var headerSeparatorMatched = 0
+    private var partHeader = MultiPartHeader()
+    private var partBody = SegmentedData()
+    private var isStreamingPart = false
+    private var bodyInflater: PartBodyInflater?
     
-    init(boundary: String) {
+    init(boundary: String, bodyStreamingFilter: ((MultiPartHeader) -> Bool)? = nil) {
         self.boundary = "--"+boundary
+        boundarySearcher = ByteSearcher(self.boundary)
+        self.bodyStreamingFilter = bodyStreamingFilter
     }
     
-    func parse(data: Data) throws -> Part {
-        guard boundary.count < data.count else {
-            throw MultiPartParserError.noData
-        }
-        
-        guard let separatorIndex = findSeparatorIndex(from: data) else {
-            throw MultiPartParserError.noData
-        }
+    /**
+     Feed received data and take parts completed by it.
+     
+     Incomplete part remains in the parser and will be completed by following data.
+     A malformed part is reported as a failure and the parser resumes from the next boundary.
+     */
+    func parse(data: Data) -> [Result<Part, Error>] {
+        var results = [Result<Part, Error>]()
         
-        let partHeader = try parsePartHeader(data: data[0..<separatorIndex+2])
-        guard let strContentSize = partHeader["Content-Length"], let contentSize = Int(strContentSize) else {
-            throw MultiPartParserError.noData
+        data.withUnsafeBytes { (rawBuffer: UnsafeRawBufferPointer) in
+            let bytes = rawBuffer.bindMemory(to: UInt8.self)
+            var index = 0
+            
+            while index < bytes.count {
+                switch state {
+                case .boundary(let matched):
+                    index = consumeBoundary(bytes, from: index, matched: matched)
+                
+                case .boundaryTail:
+                    index = consumeBoundaryTail(bytes, from: index)
+                
+                case .header:
+                    do {
+                        index = try consumeHeader(bytes, from: index)
+                    } catch {
+                        resetPart()
+                        results.append(.failure(error))
+                    }
+                
+                case .body(let remaining):
+                    // Body refers to the received data without copying.
+                    let length = min(remaining, bytes.count - index)
+                    let body = data[(data.startIndex + index)..<(data.startIndex + index + length)]
+                    index += length
+                    
+                    do {
+                        try appendBody(body, isLast: remaining == length)
+                    } catch {
+                        resetPart()
+                        results.append(.failure(error))
+                        break
+                    }
+                    
+                    guard remaining == length else {
+                        state = .body(remaining: remaining - length)
+                        break
+                    }
+                    
+                    results.append(.success(Part(header: partHeader, body: partBody, isCompleted: true)))
+                    resetPart()
+                }
+            }
+            
+            guard case let .body(remaining) = state else { return }
+            
+            if remaining == 0 {
+                // Part without body must be emitted without waiting for the next data.
+                results.append(.success(Part(header: partHeader, body: partBody, isCompleted: true)))
+                resetPart()
+            } else if isStreamingPart, 0 < partBody.count {
+                results.append(.success(Part(header: partHeader, body: partBody, isCompleted: false)))
+                partBody = SegmentedData()
+            }
         }
 
-        let partBody: Data = data.subdata(in: (separatorIndex+4)..<(separatorIndex+4+contentSize))
-        let part = Part(header: partHeader, body: partBody)
-        
-        return part
+        return results
+    }
+}
+
+// MARK: - State machine
+
+private extension MultiPartParser {
+    enum State {
+        /// Looking for the boundary. `matched` is the length of boundary prefix matched so far.
+        case boundary(matched: Int)
+        /// Skipping the rest of boundary line.
+        case boundaryTail
+        /// Collecting part header until the empty line.
+        case header
+        /// Collecting part body
+        case body(remaining: Int)
     }
     
-    func separateParts(data: Data) -> ([Data], Int) {
-        var remainedData = data
-        var parts = [Data]()
-        
-        while true {
-            guard let boundaryRange = remainedData.range(of: boundary.data(using: .utf8)!) else {
-                break
-            }
-            
-            parts.append(remainedData[0..<boundaryRange.lowerBound])
-            remainedData = remainedData.subdata(in: boundaryRange.upperBound+2..<remainedData.count)
-        }
-       
-        return (parts, data.count - remainedData.count)
+    enum Const {
+        static let maxHeaderSize = 8 * 1024
+        static let headerSeparatorSearcher = ByteSearcher(HTTPConst.crlf + HTTPConst.crlf)
+        static let hyphen = "-".data(using: .utf8)![0]
     }
     
-    private func findSeparatorIndex(from data: Data) -> Int? {
-        return data.range(of: (HTTPConst.crlf + HTTPConst.crlf).data(using: .utf8)!)?.lowerBound
+    func consumeBoundary(_ bytes: UnsafeBufferPointer<UInt8>, from startIndex: Int, matched: Int) -> Int {
+        switch boundarySearcher.match(in: bytes, from: startIndex, matched: matched) {
+        case .found(let endIndex):
+            state = .boundaryTail
+            return endIndex
+        case .partial(let matched):
+            state = .boundary(matched: matched)
+            return bytes.count
+        }
     }
     
-    private func parsePartHeader(data: Data) throws -> [String: String] {
-        var header = [String: String]()
-        var headerData = data
+    func consumeBoundaryTail(_ bytes: UnsafeBufferPointer<UInt8>, from startIndex: Int) -> Int {
+        var index = startIndex
         
-        while true {
-            guard headerData.range(of: HTTPConst.crlf.data(using: .utf8)!) != nil else {
-                return header
-            }
+        while index < bytes.count {
+            let byte = bytes[index]
+            index += 1
             
-            guard let headerKey = scanString(on: headerData, before: HTTPConst.colon) else {
+            switch byte {
+            case HTTPConst.lineFeed:
+                state = .header
+                return index
+            case Const.hyphen:
+                // Close delimiter. Ignore epilogue and wait for the next boundary.
+                resetPart()
+                return index
+            default:
+                continue
+            }
+        }
+        
+        return index
+    }
+    
+    func consumeHeader(_ bytes: UnsafeBufferPointer<UInt8>, from startIndex: Int) throws -> Int {
+        switch Const.headerSeparatorSearcher.match(in: bytes, from: startIndex, matched: headerSeparatorMatched) {
+        case .found(let endIndex):
+            // Leave the first CRLF of separator to close the last header line.
+            headerData.append(bytes.baseAddress! + startIndex, count: endIndex - startIndex)
+            headerData.removeLast(2)
+            guard headerData.count <= Const.maxHeaderSize else {
                 throw NetworkError.invalidMessageReceived
             }
-            headerData.removeSubrange(0..<(headerKey.count+2))
             
-            guard let headerValue = scanString(on: headerData, before: HTTPConst.carriageReturn) else {
+            // Header takes the bytes over. So the buffer is not copied.
+            // The next header is gathered in a new buffer of the same capacity, so it doesn't grow again.
+            partHeader = try MultiPartHeader(data: headerData)
+            headerData.removeAll(keepingCapacity: true)
+            guard let contentSize = partHeader.integer(.contentLength) else {
+                throw MultiPartParserError.noData
+            }
+            
+            if let contentEncoding = partHeader[.contentEncoding], contentEncoding.lowercased() != "identity" {
+                guard let inflater = PartBodyInflater(contentEncoding: contentEncoding) else {
+                    throw MultiPartParserError.invalidEncoding
+                }
+                
+                bodyInflater = inflater
+            }
+            
+            isStreamingPart = bodyStreamingFilter?(partHeader) ?? false
+            state = .body(remaining: contentSize)
+            return endIndex
+        
+        case .partial(let matched):
+            headerData.append(bytes.baseAddress! + startIndex, count: bytes.count - startIndex)
+            headerSeparatorMatched = matched
+            guard headerData.count <= Const.maxHeaderSize else {
                 throw NetworkError.invalidMessageReceived
             }
-            headerData.removeSubrange(0..<(headerValue.count+2))
             
-            header[headerKey] = headerValue
+            return bytes.count
         }
-        
-        return header
     }
     
-    private func scanString(on data: Data, before target: UInt8) -> String? {
-        guard let targetIndex = data.firstIndex(of: target) else {
-            return nil
+    func appendBody(_ body: Data, isLast: Bool) throws {
+        guard let bodyInflater = bodyInflater else {
+            partBody.append(body)
+            return
         }
         
-        return String(data: data[0..<targetIndex], encoding: .utf8)
+        let inflatedBody = try bodyInflater.inflate(body)
+        if 0 < inflatedBody.count {
+            partBody.append(inflatedBody)
+        }
+        
+        if isLast {
+            try bodyInflater.finish()
+        }
+    }
+    
+    func resetPart() {
+        state = .boundary(matched: 0)
+        headerData.removeAll(keepingCapacity: true)
+        headerSeparatorMatched = 0
+        partBody = SegmentedData()
+        isStreamingPart = false
+        bodyInflater = nil
     }
 }
 
 extension MultiPartParser {
     struct Part {
-        public let header: [String: String]
-        public let body: Data
+        public let header: MultiPartHeader
+        public let body: SegmentedData
+        /// `false` if the body is a fragment and the rest of body will follow.
+        public let isCompleted: Bool
     }
 }
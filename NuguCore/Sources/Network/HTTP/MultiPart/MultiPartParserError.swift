@@ -24,4 +24,6 @@ enum MultiPartParserError: Error {
     case noData
     case noBoundary
     case endOfData
+    /// The `Content-Encoding` of part is not supported or the body cannot be decoded by it.
+    case invalidEncoding
 }
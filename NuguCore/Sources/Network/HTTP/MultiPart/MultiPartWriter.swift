@@ -0,0 +1,97 @@
+//
+//  MultiPartWriter.swift
+//  NuguCore
+//
+//  Created by agent on 2026/10/16.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+import NuguUtils
+
+/**
+ Scatter-gather writer for multipart request body.
+ 
+ Boundary and static header lines are encoded once per writer.
+ Every part is made of segments (static prefix, dynamic header, body and delimiter),
+ and the body is referenced as it is. So the payload is not copied while the part is made.
+ */
+struct MultiPartWriter {
+    private let openDelimiter: Data
+    private let delimiter: Data
+    private let closeDelimiter: Data
+    
+    init(boundary: String) {
+        openDelimiter = "--\(boundary)\(HTTPConst.crlf)".data(using: .utf8)!
+        delimiter = "\(HTTPConst.crlf)--\(boundary)\(HTTPConst.crlf)".data(using: .utf8)!
+        closeDelimiter = "\(HTTPConst.crlf)--\(boundary)--\(HTTPConst.crlf)".data(using: .utf8)!
+    }
+    
+    /// The first part of request which contains an event.
+    func eventPart(body: Data) -> SegmentedData {
+        return eventParts(bodies: [body])
+    }
+    
+    /**
+     The first parts of request which contain the events. (ex. batched events)
+     
+     Only the first part has the open delimiter. The others follow the delimiter which closes the previous part.
+     */
+    func eventParts(bodies: [Data]) -> SegmentedData {
+        var parts = SegmentedData()
+        parts.append(openDelimiter)
+        bodies.forEach { body in
+            parts.append(Const.eventHeader)
+            parts.append(body)
+            parts.append(delimiter)
+        }
+        
+        return parts
+    }
+    
+    /// The part which contains an attachment. It follows the event part.
+    func attachmentPart(seq: Int32, isEnd: Bool, type: String, messageId: String, content: Data) -> SegmentedData {
+        let dynamicHeader = "\(seq);\(isEnd ? "end" : "continued")\""
+            + HTTPConst.crlf + "Content-Type: \(type)"
+            + HTTPConst.crlf + "Message-Id: \(messageId)"
+            + HTTPConst.crlf + HTTPConst.crlf
+        
+        var part = SegmentedData()
+        part.append(Const.attachmentHeaderPrefix)
+        part.append(dynamicHeader.data(using: .utf8)!)
+        part.append(content)
+        part.append(delimiter)
+        
+        return part
+    }
+    
+    /// Delimiter to notify the end of request.
+    var closePart: SegmentedData {
+        return SegmentedData(closeDelimiter)
+    }
+}
+
+// MARK: - Const
+
+private extension MultiPartWriter {
+    enum Const {
+        static let eventHeader = ("Content-Disposition: form-data; name=\"event\""
+            + HTTPConst.crlf + "Content-Type: application/json"
+            + HTTPConst.crlf + HTTPConst.crlf).data(using: .utf8)!
+        
+        static let attachmentHeaderPrefix = "Content-Disposition: form-data; name=\"attachment\"; filename=\"".data(using: .utf8)!
+    }
+}
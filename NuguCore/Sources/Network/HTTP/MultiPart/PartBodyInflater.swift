@@ -0,0 +1,184 @@
+//
+//  PartBodyInflater.swift
+//  NuguCore
+//
+//  Created by agent on 2026/10/17.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+import Compression
+
+/**
+ Incremental inflater of the part body which has `Content-Encoding`.
+ 
+ The compressed body is fed as it is received and the inflated bytes are returned right away.
+ `gzip` and `deflate` (zlib wrapped or raw) are supported. The wrapper header is skipped and the trailer is ignored.
+ */
+final class PartBodyInflater {
+    private let encoding: Encoding
+    private let stream = UnsafeMutablePointer<compression_stream>.allocate(capacity: 1)
+    private let outputBuffer = UnsafeMutablePointer<UInt8>.allocate(capacity: Const.outputBufferSize)
+    /// The wrapper header received so far. It is `nil` after the header is skipped.
+    private var headerData: Data? = Data()
+    private var isFinished = false
+    
+    /// Returns `nil` if the content encoding is not supported.
+    init?(contentEncoding: String) {
+        guard let encoding = Encoding(rawValue: contentEncoding.trimmingCharacters(in: .whitespaces).lowercased()),
+            compression_stream_init(stream, COMPRESSION_STREAM_DECODE, COMPRESSION_ZLIB) == COMPRESSION_STATUS_OK else {
+                stream.deallocate()
+                outputBuffer.deallocate()
+                return nil
+        }
+        
+        self.encoding = encoding
+    }
+    
+    deinit {
+        compression_stream_destroy(stream)
+        stream.deallocate()
+        outputBuffer.deallocate()
+    }
+    
+    func inflate(_ data: Data) throws -> Data {
+        guard var headerData = headerData else {
+            return try process(data)
+        }
+        
+        // Wait for the whole wrapper header.
+        headerData.append(data)
+        guard let headerLength = try encoding.headerLength(of: headerData) else {
+            self.headerData = headerData
+            return Data()
+        }
+        
+        self.headerData = nil
+        return try process(headerData.subdata(in: headerLength..<headerData.count))
+    }
+    
+    /// Checks that the compressed body is complete.
+    func finish() throws {
+        guard isFinished else {
+            throw MultiPartParserError.endOfData
+        }
+    }
+}
+
+// MARK: - Private
+
+private extension PartBodyInflater {
+    enum Const {
+        static let outputBufferSize = 16 * 1024
+    }
+    
+    func process(_ data: Data) throws -> Data {
+        guard isFinished == false, 0 < data.count else { return Data() }
+        
+        var inflatedData = Data()
+        var status = COMPRESSION_STATUS_OK
+        data.withUnsafeBytes { (rawBuffer: UnsafeRawBufferPointer) in
+            stream.pointee.src_ptr = rawBuffer.bindMemory(to: UInt8.self).baseAddress!
+            stream.pointee.src_size = rawBuffer.count
+            
+            repeat {
+                stream.pointee.dst_ptr = outputBuffer
+                stream.pointee.dst_size = Const.outputBufferSize
+                status = compression_stream_process(stream, 0)
+                inflatedData.append(outputBuffer, count: Const.outputBufferSize - stream.pointee.dst_size)
+            } while status == COMPRESSION_STATUS_OK && (0 < stream.pointee.src_size || stream.pointee.dst_size == 0)
+        }
+        
+        switch status {
+        case COMPRESSION_STATUS_OK:
+            break
+        case COMPRESSION_STATUS_END:
+            // The trailer (checksum and size) follows the last block.
+            isFinished = true
+        default:
+            throw MultiPartParserError.invalidEncoding
+        }
+        
+        return inflatedData
+    }
+}
+
+// MARK: - Encoding
+
+private extension PartBodyInflater {
+    enum Encoding: String {
+        case gzip
+        case deflate
+        
+        /**
+         Returns the length of wrapper header before the raw deflate data.
+         
+         - Returns: `nil` if more data is required to know it.
+         */
+        func headerLength(of data: Data) throws -> Int? {
+            let bytes = [UInt8](data.prefix(Const.maxFixedHeaderLength))
+            
+            switch self {
+            case .deflate:
+                guard 2 <= bytes.count else { return nil }
+                
+                // zlib header (RFC 1950). Some servers send raw deflate without it.
+                let isZlibWrapped = bytes[0] & 0x0f == 8 && (UInt16(bytes[0]) << 8 | UInt16(bytes[1])) % 31 == 0
+                guard isZlibWrapped else { return 0 }
+                guard bytes[1] & Const.zlibPresetDictionary == 0 else {
+                    throw MultiPartParserError.invalidEncoding
+                }
+                
+                return 2
+            case .gzip:
+                // gzip header (RFC 1952)
+                guard Const.gzipFixedHeaderLength <= bytes.count else { return nil }
+                guard bytes[0] == 0x1f, bytes[1] == 0x8b, bytes[2] == 8 else {
+                    throw MultiPartParserError.invalidEncoding
+                }
+                
+                let flags = bytes[3]
+                var index = data.startIndex + Const.gzipFixedHeaderLength
+                if flags & Const.gzipExtra != 0 {
+                    guard index + 2 <= data.endIndex else { return nil }
+                    
+                    index += 2 + (Int(data[index]) | Int(data[index + 1]) << 8)
+                }
+                for flag in [Const.gzipName, Const.gzipComment] where flags & flag != 0 {
+                    guard index < data.endIndex, let terminator = data[index...].firstIndex(of: 0) else { return nil }
+                    
+                    index = terminator + 1
+                }
+                if flags & Const.gzipHeaderCRC != 0 {
+                    index += 2
+                }
+                
+                guard index <= data.endIndex else { return nil }
+                
+                return index - data.startIndex
+            }
+        }
+        
+        enum Const {
+            static let maxFixedHeaderLength = 10
+            static let zlibPresetDictionary: UInt8 = 0x20
+            static let gzipFixedHeaderLength = 10
+            static let gzipHeaderCRC: UInt8 = 0x02
+            static let gzipExtra: UInt8 = 0x04
+            static let gzipName: UInt8 = 0x08
+            static let gzipComment: UInt8 = 0x10
+        }
+    }
+}
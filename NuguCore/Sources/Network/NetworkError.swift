@@ -58,6 +58,9 @@ public enum NetworkError: Error {
     /// The error occurs on the server.
     case serverError
     
+    /// The deferred event is dropped before it is sent, because the event journal is full.
+    case eventDropped
+    
     /// The error occurs by unknown or complicated issue.
     case unknown
 }
@@ -83,6 +86,8 @@ extension NetworkError: LocalizedError {
             return "Invalid message has received"
         case .serverError:
             return "server error"
+        case .eventDropped:
+            return "Deferred event is dropped"
         case .unknown:
             return "Unknown error occur"
         case .noSuitableResourceServer:
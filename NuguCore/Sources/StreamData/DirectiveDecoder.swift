@@ -0,0 +1,329 @@
+//
+//  DirectiveDecoder.swift
+//  NuguCore
+//
+//  Created by agent on 2026/10/16.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+import NuguUtils
+
+/**
+ Decoder of the directives body. `{ "directives": [ { "header": { ... }, "payload": { ... } }, ... ] }`
+ 
+ The body is scanned only once.
+ Header fields are decoded straight into `Downstream.Header`, and payload is copied out of the body without re-encoding.
+ Payload is skipped by matching brackets only. It is validated when the agent decodes it.
+ 
+ Each payload is a `Data` of its own which starts from index zero. It doesn't keep the body alive after decoding.
+ */
+enum DirectiveDecoder {
+    /**
+     Decodes the directives from the part body.
+     
+     The body of one segment is scanned in place. The segmented one is made contiguous once, and released after decoding.
+     */
+    static func decode(_ body: SegmentedData) throws -> [Downstream.Directive] {
+        return try decode(body.data)
+    }
+    
+    /// Decodes the directives. The directive which doesn't have valid header or payload is omitted.
+    static func decode(_ data: Data) throws -> [Downstream.Directive] {
+        return try data.withUnsafeBytes { (rawBuffer: UnsafeRawBufferPointer) -> [Downstream.Directive] in
+            var scanner = Scanner(bytes: rawBuffer.bindMemory(to: UInt8.self))
+            var directives: [Downstream.Directive]?
+            
+            try scanner.scanObject { key, scanner in
+                guard key == "directives" else {
+                    try scanner.skipValue()
+                    return
+                }
+                
+                var decodedDirectives = [Downstream.Directive]()
+                try scanner.scanArray { scanner in
+                    if let directive = try scanDirective(&scanner) {
+                        decodedDirectives.append(directive)
+                    }
+                }
+                directives = decodedDirectives
+            }
+            
+            guard let decodedDirectives = directives else {
+                throw NetworkError.invalidMessageReceived
+            }
+            
+            return decodedDirectives
+        }
+    }
+}
+
+// MARK: - Directive
+
+private extension DirectiveDecoder {
+    static func scanDirective(_ scanner: inout Scanner) throws -> Downstream.Directive? {
+        guard scanner.peek() == Const.leftBrace else {
+            try scanner.skipValue()
+            return nil
+        }
+        
+        var header: Downstream.Header?
+        var payload: Data?
+        try scanner.scanObject { key, scanner in
+            switch key {
+            case "header":
+                header = try scanHeader(&scanner)
+            case "payload" where scanner.peek() == Const.leftBrace:
+                // Copied, so the payload doesn't hold the whole body and its indices start from zero.
+                let range = try scanner.skipValue()
+                payload = Data(scanner.bytes[range])
+            default:
+                try scanner.skipValue()
+            }
+        }
+        
+        guard let directiveHeader = header, let directivePayload = payload else { return nil }
+        
+        return Downstream.Directive(header: directiveHeader, payload: directivePayload)
+    }
+    
+    static func scanHeader(_ scanner: inout Scanner) throws -> Downstream.Header? {
+        guard scanner.peek() == Const.leftBrace else {
+            try scanner.skipValue()
+            return nil
+        }
+        
+        var fields = [String: String]()
+        var messageTimestamp: Int?
+        var isValid = true
+        try scanner.scanObject { key, scanner in
+            switch (key, scanner.peek()) {
+            case ("namespace", .some(Const.quotationMark)),
+                 ("name", .some(Const.quotationMark)),
+                 ("dialogRequestId", .some(Const.quotationMark)),
+                 ("messageId", .some(Const.quotationMark)),
+                 ("version", .some(Const.quotationMark)):
+                fields[key] = try scanner.scanString()
+            case ("namespace", _), ("name", _), ("dialogRequestId", _), ("messageId", _), ("version", _):
+                isValid = false
+                try scanner.skipValue()
+            case ("messageTimestamp", _):
+                let token = try scanner.skipValue()
+                let value = String(decoding: UnsafeBufferPointer(rebasing: scanner.bytes[token]), as: UTF8.self)
+                if value != "null" {
+                    messageTimestamp = Int(value)
+                    isValid = isValid && messageTimestamp != nil
+                }
+            default:
+                try scanner.skipValue()
+            }
+        }
+        
+        guard isValid,
+            let namespace = fields["namespace"],
+            let name = fields["name"],
+            let dialogRequestId = fields["dialogRequestId"],
+            let messageId = fields["messageId"],
+            let version = fields["version"] else {
+                return nil
+        }
+        
+        return Downstream.Header(
+            namespace: namespace,
+            name: name,
+            dialogRequestId: dialogRequestId,
+            messageId: messageId,
+            version: version,
+            messageTimestamp: messageTimestamp
+        )
+    }
+}
+
+// MARK: - Scanner
+
+private extension DirectiveDecoder {
+    struct Scanner {
+        let bytes: UnsafeBufferPointer<UInt8>
+        private var index = 0
+        
+        init(bytes: UnsafeBufferPointer<UInt8>) {
+            self.bytes = bytes
+        }
+        
+        /// Returns the next byte which is not a whitespace.
+        mutating func peek() -> UInt8? {
+            while index < bytes.count, Const.whitespaces.contains(bytes[index]) {
+                index += 1
+            }
+            
+            return index < bytes.count ? bytes[index] : nil
+        }
+        
+        mutating func scanObject(_ member: (String, inout Scanner) throws -> Void) throws {
+            try expect(Const.leftBrace)
+            if peek() == Const.rightBrace {
+                index += 1
+                return
+            }
+            
+            repeat {
+                let key = try scanString()
+                try expect(Const.colon)
+                try member(key, &self)
+            } while try scanSeparator(closing: Const.rightBrace)
+        }
+        
+        mutating func scanArray(_ element: (inout Scanner) throws -> Void) throws {
+            try expect(Const.leftBracket)
+            if peek() == Const.rightBracket {
+                index += 1
+                return
+            }
+            
+            repeat {
+                try element(&self)
+            } while try scanSeparator(closing: Const.rightBracket)
+        }
+        
+        mutating func scanString() throws -> String {
+            let range = try skipString()
+            let rawString = UnsafeBufferPointer(rebasing: bytes[(range.lowerBound + 1)..<(range.upperBound - 1)])
+            
+            guard rawString.contains(Const.backslash) else {
+                return String(decoding: rawString, as: UTF8.self)
+            }
+            
+            // Escaped string is rare in the header. Leave it to `JSONSerialization`.
+            let quotedString = Data(UnsafeBufferPointer(rebasing: bytes[range]))
+            guard let string = try JSONSerialization.jsonObject(with: quotedString, options: .allowFragments) as? String else {
+                throw NetworkError.invalidMessageReceived
+            }
+            
+            return string
+        }
+        
+        /// Skips any value and returns the range of it.
+        @discardableResult mutating func skipValue() throws -> Range<Int> {
+            switch peek() {
+            case .some(Const.quotationMark):
+                return try skipString()
+            case .some(Const.leftBrace), .some(Const.leftBracket):
+                return try skipContainer()
+            case .some:
+                // Number or literal (true, false and null)
+                let startIndex = index
+                while index < bytes.count, Const.tokenTerminators.contains(bytes[index]) == false {
+                    index += 1
+                }
+                guard startIndex < index else {
+                    throw NetworkError.invalidMessageReceived
+                }
+                
+                return startIndex..<index
+            case .none:
+                throw NetworkError.invalidMessageReceived
+            }
+        }
+        
+        private mutating func expect(_ byte: UInt8) throws {
+            guard peek() == byte else {
+                throw NetworkError.invalidMessageReceived
+            }
+            
+            index += 1
+        }
+        
+        /// Returns `true` if there are more elements.
+        private mutating func scanSeparator(closing: UInt8) throws -> Bool {
+            switch peek() {
+            case .some(Const.comma):
+                index += 1
+                return true
+            case .some(closing):
+                index += 1
+                return false
+            default:
+                throw NetworkError.invalidMessageReceived
+            }
+        }
+        
+        /// Skips the string including quotation marks.
+        private mutating func skipString() throws -> Range<Int> {
+            try expect(Const.quotationMark)
+            let startIndex = index - 1
+            
+            while index < bytes.count {
+                switch bytes[index] {
+                case Const.quotationMark:
+                    index += 1
+                    return startIndex..<index
+                case Const.backslash:
+                    index += 2
+                default:
+                    index += 1
+                }
+            }
+            
+            throw NetworkError.invalidMessageReceived
+        }
+        
+        /// Skips the object or array by matching brackets.
+        private mutating func skipContainer() throws -> Range<Int> {
+            let startIndex = index
+            var depth = 0
+            
+            while index < bytes.count {
+                switch bytes[index] {
+                case Const.quotationMark:
+                    _ = try skipString()
+                    continue
+                case Const.leftBrace, Const.leftBracket:
+                    depth += 1
+                case Const.rightBrace, Const.rightBracket:
+                    depth -= 1
+                    if depth == 0 {
+                        index += 1
+                        return startIndex..<index
+                    }
+                default:
+                    break
+                }
+                
+                index += 1
+            }
+            
+            throw NetworkError.invalidMessageReceived
+        }
+    }
+}
+
+// MARK: - Const
+
+private extension DirectiveDecoder {
+    enum Const {
+        static let leftBrace = "{".data(using: .utf8)![0]
+        static let rightBrace = "}".data(using: .utf8)![0]
+        static let leftBracket = "[".data(using: .utf8)![0]
+        static let rightBracket = "]".data(using: .utf8)![0]
+        static let comma = ",".data(using: .utf8)![0]
+        static let colon = ":".data(using: .utf8)![0]
+        static let quotationMark = "\"".data(using: .utf8)![0]
+        static let backslash = "\\".data(using: .utf8)![0]
+        
+        static let whitespaces = Set(" \t\r\n".utf8)
+        static let tokenTerminators = whitespaces.union([comma, rightBrace, rightBracket])
+    }
+}
@@ -0,0 +1,104 @@
+//
+//  EventBatcher.swift
+//  NuguCore
+//
+//  Created by agent on 2026/10/17.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+import NuguUtils
+
+import RxSwift
+
+/**
+ Holds the batchable events for a short window, so they can be sent in one request.
+ 
+ The batch is flushed when the window of the first event is elapsed or it is full.
+ */
+class EventBatcher {
+    typealias Item = (event: Upstream.Event, completion: ((StreamDataState) -> Void)?)
+    
+    private let maxCount: Int
+    private let scheduler = ConcurrentDispatchQueueScheduler(qos: .utility)
+    @Atomic private var items = [Item]()
+    @Atomic private var windowDisposable: Disposable?
+    
+    /// Called with the events which should be sent together.
+    var flushHandler: (([Item]) -> Void)?
+    
+    /// - Parameter maxCount: The batch is flushed as soon as it has this number of events.
+    init(maxCount: Int) {
+        self.maxCount = maxCount
+    }
+    
+    func append(_ event: Upstream.Event, window: TimeInterval, completion: ((StreamDataState) -> Void)?) {
+        var isFirst = false
+        var isFull = false
+        _items.mutate {
+            $0.append((event: event, completion: completion))
+            isFirst = $0.count == 1
+            isFull = maxCount <= $0.count
+        }
+        
+        if isFull {
+            flush()
+        } else if isFirst {
+            let disposable = Observable<Int>.timer(.milliseconds(Int(window * 1000)), scheduler: scheduler)
+                .subscribe(onNext: { [weak self] _ in
+                    self?.flush()
+                })
+            
+            _windowDisposable.mutate {
+                $0?.dispose()
+                $0 = disposable
+            }
+        }
+    }
+    
+    /**
+     Removes the event which is not flushed yet.
+     
+     - Returns: The removed one. `nil` if it is not held.
+     */
+    func remove(dialogRequestId: String) -> Item? {
+        var removedItem: Item?
+        _items.mutate {
+            guard let index = $0.firstIndex(where: { $0.event.header.dialogRequestId == dialogRequestId }) else { return }
+            
+            removedItem = $0.remove(at: index)
+        }
+        
+        return removedItem
+    }
+    
+    func flush() {
+        _windowDisposable.mutate {
+            $0?.dispose()
+            $0 = nil
+        }
+        
+        var flushedItems = [Item]()
+        _items.mutate {
+            flushedItems = $0
+            $0.removeAll()
+        }
+        
+        guard flushedItems.isEmpty == false else { return }
+        
+        flushHandler?(flushedItems)
+    }
+}
@@ -0,0 +1,274 @@
+//
+//  EventJournal.swift
+//  NuguCore
+//
+//  Created by agent on 2026/10/17.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/**
+ Append-only journal of the events which are deferred while offline.
+ 
+ The file is mapped to the memory, so appending an event is a memory copy and the system writes it back to the file.
+ The file is `header | record | record | ...` and the record is `length(UInt32) | body of event part`.
+ The header keeps the offsets of the first and the end of records. (`magic | head(UInt32) | tail(UInt32) | reserved(UInt32)`)
+ When the journal is full, the records are moved to the front and the oldest ones are dropped if it is still full.
+ */
+class EventJournal {
+    private let capacity: Int
+    private let fileDescriptor: Int32
+    private let buffer: UnsafeMutableRawPointer
+    private let journalQueue = DispatchQueue(label: "com.sktelecom.romaine.core.event_journal")
+    
+    /// Called with `messageId` of the events which are dropped because the journal is full. It is called on the queue of the journal.
+    var droppedEventsHandler: ((_ messageIds: [String]) -> Void)?
+    
+    /**
+     - Parameter url: The journal file. The records in it are kept.
+     - Parameter capacity: The size of the journal file.
+     */
+    init(url: URL, capacity: Int) throws {
+        self.capacity = capacity
+        
+        fileDescriptor = open(url.path, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR)
+        guard 0 <= fileDescriptor else {
+            throw NetworkError.invalidParameter
+        }
+        
+        guard ftruncate(fileDescriptor, off_t(capacity)) == 0,
+            let mappedBuffer = mmap(nil, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0),
+            mappedBuffer != MAP_FAILED else {
+                close(fileDescriptor)
+                throw NetworkError.invalidParameter
+        }
+        buffer = mappedBuffer
+        
+        // Initialize the new or broken journal.
+        if load(at: 0) != Const.magic || head < Const.headerSize || tail < head || capacity < tail {
+            store(Const.magic, at: 0)
+            head = Const.headerSize
+            tail = Const.headerSize
+        }
+    }
+    
+    deinit {
+        munmap(buffer, capacity)
+        close(fileDescriptor)
+    }
+    
+    /// Appends the event without waiting for it to be written.
+    func append(_ event: Upstream.Event) {
+        journalQueue.async { [weak self] in
+            guard let self = self else { return }
+            
+            var jsonWriter = JSONStreamWriter()
+            event.writeBody(to: &jsonWriter)
+            let droppedMessageIds = self.append(record: jsonWriter.data)
+            if droppedMessageIds.isEmpty == false {
+                self.droppedEventsHandler?(droppedMessageIds)
+            }
+        }
+    }
+    
+    /**
+     The oldest events in the journal. They are kept until `removeFirst(messageIds:)` is called.
+     
+     The broken records at the front are removed, and the other broken ones are skipped.
+     - Parameter maxCount: The maximum number of events.
+     */
+    func prefix(_ maxCount: Int) -> [Upstream.Event] {
+        return journalQueue.sync {
+            var events = [Upstream.Event]()
+            var offset = head
+            while offset < tail, events.count < maxCount {
+                if let event = event(at: offset) {
+                    events.append(event)
+                } else {
+                    log.error("journaled event is broken")
+                    if events.isEmpty {
+                        removeHeadRecord()
+                        offset = head
+                        continue
+                    }
+                }
+                
+                offset += Const.lengthSize + recordLength(at: offset)
+            }
+            
+            return events
+        }
+    }
+    
+    /**
+     Removes the oldest events after they are sent.
+     
+     - Parameter messageIds: The events are removed from the oldest one while it is one of them.
+     They can be dropped already when the journal was full. The broken records among them are removed together.
+     */
+    func removeFirst(messageIds: [String]) {
+        let messageIds = Set(messageIds)
+        journalQueue.async { [weak self] in
+            guard let self = self else { return }
+            
+            while self.head < self.tail {
+                if let event = self.event(at: self.head), messageIds.contains(event.header.messageId) == false {
+                    return
+                }
+                
+                self.removeHeadRecord()
+            }
+        }
+    }
+}
+
+// MARK: - Private
+
+private extension EventJournal {
+    enum Const {
+        /// "NGEJ"
+        static let magic: UInt32 = 0x4E47454A
+        static let headerSize = 16
+        static let headOffset = 4
+        static let tailOffset = 8
+        static let lengthSize = MemoryLayout<UInt32>.size
+    }
+    
+    var head: Int {
+        get {
+            Int(load(at: Const.headOffset))
+        }
+        
+        set {
+            store(UInt32(newValue), at: Const.headOffset)
+        }
+    }
+    
+    var tail: Int {
+        get {
+            Int(load(at: Const.tailOffset))
+        }
+        
+        set {
+            store(UInt32(newValue), at: Const.tailOffset)
+        }
+    }
+    
+    func recordLength(at offset: Int) -> Int {
+        return Int(load(at: offset))
+    }
+    
+    func event(at offset: Int) -> Upstream.Event? {
+        let body = Data(bytes: buffer + offset + Const.lengthSize, count: recordLength(at: offset))
+        return Upstream.Event(body: body)
+    }
+    
+    func removeHeadRecord() {
+        head += Const.lengthSize + recordLength(at: head)
+        if head == tail {
+            head = Const.headerSize
+            tail = Const.headerSize
+        }
+    }
+    
+    /// Records are not aligned. So the integers are copied byte by byte.
+    func load(at offset: Int) -> UInt32 {
+        var value: UInt32 = 0
+        memcpy(&value, buffer + offset, MemoryLayout<UInt32>.size)
+        return value
+    }
+    
+    func store(_ value: UInt32, at offset: Int) {
+        var value = value
+        memcpy(buffer + offset, &value, MemoryLayout<UInt32>.size)
+    }
+    
+    /// - Returns: `messageId` of the events dropped to make room for the record.
+    func append(record: Data) -> [String] {
+        let recordSize = Const.lengthSize + record.count
+        guard recordSize <= capacity - Const.headerSize else {
+            log.error("event is too large to be journaled: \(record.count)")
+            return []
+        }
+        
+        var droppedMessageIds = [String]()
+        if capacity < tail + recordSize {
+            droppedMessageIds = compact(freeSize: recordSize)
+        }
+        
+        // The record is written before the tail is moved. So the broken record is not read.
+        store(UInt32(record.count), at: tail)
+        record.withUnsafeBytes { bytes in
+            (buffer + tail + Const.lengthSize).copyMemory(from: bytes.baseAddress!, byteCount: record.count)
+        }
+        tail += recordSize
+        
+        return droppedMessageIds
+    }
+    
+    /**
+     Moves the records to the front. The oldest records are dropped until `freeSize` is available.
+     
+     - Returns: `messageId` of the dropped events. The broken records are dropped without it.
+     */
+    func compact(freeSize: Int) -> [String] {
+        var newHead = head
+        var droppedCount = 0
+        var droppedMessageIds = [String]()
+        while newHead < tail, capacity < Const.headerSize + (tail - newHead) + freeSize {
+            if let messageId = event(at: newHead)?.header.messageId {
+                droppedMessageIds.append(messageId)
+            }
+            newHead += Const.lengthSize + recordLength(at: newHead)
+            droppedCount += 1
+        }
+        
+        if 0 < droppedCount {
+            log.warning("journal is full. \(droppedCount) oldest events are dropped")
+        }
+        
+        let liveSize = tail - newHead
+        (buffer + Const.headerSize).copyMemory(from: buffer + newHead, byteCount: liveSize)
+        head = Const.headerSize
+        tail = Const.headerSize + liveSize
+        
+        return droppedMessageIds
+    }
+}
+
+// MARK: - Upstream.Event
+
+private extension Upstream.Event {
+    /// Restores the event from the body written by `writeBody(to:)`.
+    init?(body: Data) {
+        guard let dictionary = try? JSONSerialization.jsonObject(with: body, options: []) as? [String: Any],
+            let eventDictionary = dictionary["event"] as? [String: Any],
+            let headerDictionary = eventDictionary["header"] as? [String: Any],
+            let headerData = try? JSONSerialization.data(withJSONObject: headerDictionary, options: []),
+            let header = try? JSONDecoder().decode(Upstream.Header.self, from: headerData),
+            let payload = eventDictionary["payload"] as? [String: AnyHashable] else {
+                return nil
+        }
+        
+        let contextDictionary = dictionary["context"] as? [String: Any]
+        let capabilityContexts = (contextDictionary?["supportedInterfaces"] as? [String: AnyHashable] ?? [:])
+            .map { ContextInfo(contextType: .capability, name: $0.key, payload: $0.value) }
+        let clientContexts = (contextDictionary?["client"] as? [String: AnyHashable] ?? [:])
+            .map { ContextInfo(contextType: .client, name: $0.key, payload: $0.value) }
+        
+        self.init(payload: payload, header: header, contextPayload: capabilityContexts + clientContexts)
+    }
+}
@@ -32,14 +32,23 @@ class EventSender {
     private static var id = 0
     public let id: Int
     private let boundary: String
+    private let writer: MultiPartWriter
     private let streamQueue: DispatchQueue
     let inputStream = DataBoundInputStream(data: Data())
     
+    /**
+     Called when the upload buffer reaches the high watermark and when it drains to the low watermark.
+     
+     `durationOverHighWatermark` is the time spent over the high watermark. It is set only when the buffer drains.
+     */
+    var bufferStateHandler: ((_ isOverHighWatermark: Bool, _ bufferedBytes: Int, _ durationOverHighWatermark: TimeInterval?) -> Void)?
+    @Atomic private var overHighWatermarkDate: Date?
+    
     #if DEBUG
     private var sentData = Data()
     #endif
     
-    public init(boundary: String) {
+    public init(boundary: String, watermark: DataBoundInputStream.Watermark? = nil) {
         if EventSender.id == Int.max {
             EventSender.id = 0
         }
@@ -47,7 +56,13 @@ class EventSender {
         EventSender.id += 1
         
         self.boundary = boundary
+        writer = MultiPartWriter(boundary: boundary)
         streamQueue = DispatchQueue(label: "com.sktelecom.romaine.event_sender_stream_\(boundary)")
+        
+        inputStream.watermark = watermark
+        inputStream.watermarkHandler = { [weak self] (isOverHighWatermark, bufferedBytes) in
+            self?.bufferStateChanged(isOverHighWatermark: isOverHighWatermark, bufferedBytes: bufferedBytes)
+        }
 
         log.debug("[\(id)] initiated")
     }
@@ -60,8 +75,19 @@ class EventSender {
      - Parameter event: UpstreamEventMessage you want to send.
      */
     func send(_ event: Upstream.Event) {
-        log.debug("[\(id)] try send event")
-        inputStream.appendData(makeMultipartData(event))
+        send([event])
+    }
+    
+    /**
+     Send the events as the first parts of multipart.
+     
+     The events must be sent at once. Only the first part opens the multipart.
+     
+     - Parameter events: UpstreamEventMessages you want to send together.
+     */
+    func send(_ events: [Upstream.Event]) {
+        log.debug("[\(id)] try send \(events.count) events")
+        inputStream.appendData(makeMultipartData(events))
     }
     
     /**
@@ -78,13 +104,9 @@ class EventSender {
     func finish() {
         log.debug("[\(id)] finish")
         
-        var partData = Data()
-        partData.append(HTTPConst.crlfData)
-        partData.append("--\(self.boundary)--".data(using: .utf8)!)
-        partData.append(HTTPConst.crlfData)
-        
-        log.debug("\n\(String(data: partData, encoding: .utf8) ?? "")")
-        inputStream.appendData(partData)
+        let part = writer.closePart
+        log.debug("\n\(String(data: part.data, encoding: .utf8) ?? "")")
+        inputStream.appendData(part)
         inputStream.lastDataAppended()
         
         #if DEBUG
@@ -100,53 +122,56 @@ class EventSender {
     }
 }
 
-// MARK: - Multipart
+// MARK: - Upload buffer
 
 private extension EventSender {
-    func makeMultipartData(_ event: Upstream.Event) -> Data {
-        let bodyData = ("{ \"context\": \(event.contextString)"
-            + ",\"event\": {"
-            + "\"header\": \(event.headerString)"
-            + ",\"payload\": \(event.payloadString) }"
-            + " }").data(using: .utf8)!
+    func bufferStateChanged(isOverHighWatermark: Bool, bufferedBytes: Int) {
+        var durationOverHighWatermark: TimeInterval?
+        _overHighWatermarkDate.mutate {
+            if isOverHighWatermark {
+                $0 = Date()
+            } else {
+                durationOverHighWatermark = $0.map { Date().timeIntervalSince($0) }
+                $0 = nil
+            }
+        }
         
-        let headerLines = [
-            "Content-Disposition: form-data; name=\"event\"",
-            "Content-Type: application/json"
-        ]
+        if isOverHighWatermark {
+            log.warning("[\(id)] upload is stalled. \(bufferedBytes) bytes are buffered")
+        } else {
+            log.info("[\(id)] upload is resumed after \(durationOverHighWatermark ?? 0) sec. \(bufferedBytes) bytes are buffered")
+        }
         
-        var partData = Data()
-        partData.append("--\(boundary)".data(using: .utf8)!)
-        partData.append(HTTPConst.crlfData)
-        partData.append(headerLines.joined(separator: (HTTPConst.crlf)).data(using: .utf8)!)
-        partData.append(HTTPConst.crlfData)
-        partData.append(HTTPConst.crlfData)
-        partData.append(bodyData)
-        partData.append(HTTPConst.crlfData)
-        partData.append("--\(boundary)".data(using: .utf8)!)
-        partData.append(HTTPConst.crlfData)
+        bufferStateHandler?(isOverHighWatermark, bufferedBytes, durationOverHighWatermark)
+    }
+}
 
-        log.debug("[\(id)] \n\(String(data: partData, encoding: .utf8) ?? "")")
-        return partData
+// MARK: - Multipart
+
+private extension EventSender {
+    func makeMultipartData(_ events: [Upstream.Event]) -> SegmentedData {
+        // JSON body is written into one buffer and it becomes a segment of the part without copying.
+        let bodies = events.map { (event) -> Data in
+            var jsonWriter = JSONStreamWriter()
+            event.writeBody(to: &jsonWriter)
+            return jsonWriter.data
+        }
+        
+        let parts = writer.eventParts(bodies: bodies)
+        log.debug("[\(id)] \n\(String(data: parts.data, encoding: .utf8) ?? "")")
+        return parts
     }
     
-    func makeMultipartData(_ attachment: Upstream.Attachment) -> Data {
-        let headerLines = [
-            "Content-Disposition: form-data; name=\"attachment\"; filename=\"\(attachment.seq);\(attachment.isEnd ? "end" : "continued")\"",
-            "Content-Type: \(attachment.type)",
-            "Message-Id: \(attachment.header.messageId)"
-        ]
+    func makeMultipartData(_ attachment: Upstream.Attachment) -> SegmentedData {
+        let part = writer.attachmentPart(
+            seq: attachment.seq,
+            isEnd: attachment.isEnd,
+            type: attachment.type,
+            messageId: attachment.header.messageId,
+            content: attachment.content
+        )
         
-        var partData = Data()
-        partData.append(headerLines.joined(separator: (HTTPConst.crlf)).data(using: .utf8)!)
-        partData.append(HTTPConst.crlfData)
-        partData.append(HTTPConst.crlfData)
-        partData.append(attachment.content)
-        partData.append(HTTPConst.crlfData)
-        partData.append("--\(boundary)".data(using: .utf8)!)
-        partData.append(HTTPConst.crlfData)
-
-        log.debug("[\(id)] Data(\(attachment.content)):\n\(String(data: partData, encoding: .utf8) ?? "")")
-        return partData
+        log.debug("[\(id)] Data(\(attachment.content)), part: \(part.count) bytes in \(part.segments.count) segments")
+        return part
     }
 }
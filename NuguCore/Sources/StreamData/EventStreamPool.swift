@@ -0,0 +1,175 @@
+//
+//  EventStreamPool.swift
+//  NuguCore
+//
+//  Created by agent on 2026/10/16.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+import NuguUtils
+
+import RxSwift
+
+/**
+ Holds one upload stream which is opened before the event is ready.
+ 
+ The request of prepared stream is sent without body, and it is bound to the next event which doesn't have extra http header fields.
+ The stream which is not bound in `idleTimeout` is discarded, because the server closes the request which doesn't send anything.
+ */
+class EventStreamPool {
+    private let apiProvider: NuguApiProvider
+    private let idleTimeout: RxTimeInterval
+    @Atomic private var preparedStream: PreparedStream?
+    
+    init(apiProvider: NuguApiProvider, idleTimeout: RxTimeInterval) {
+        self.apiProvider = apiProvider
+        self.idleTimeout = idleTimeout
+    }
+    
+    /// Opens an upload stream if there's no prepared one.
+    func prepare(watermark: DataBoundInputStream.Watermark?) {
+        guard let header = NuguApi.events.header else { return }
+        
+        let stream = PreparedStream(boundary: HTTPConst.boundaryPrefix + UUID().uuidString, header: header, watermark: watermark)
+        
+        // The stream is stored before the upload starts, so that the termination can discard it.
+        var isStored = false
+        _preparedStream.mutate {
+            guard $0 == nil else { return }
+            
+            $0 = stream
+            isStored = true
+        }
+        guard isStored else { return }
+        
+        // The stream terminated before it is bound cannot be used.
+        stream.subject
+            .subscribe(onError: { [weak self, weak stream] _ in
+                self?.discard(stream)
+            }, onCompleted: { [weak self, weak stream] in
+                self?.discard(stream)
+            })
+            .disposed(by: stream.expirationDisposeBag)
+        
+        Observable<Int>.timer(idleTimeout, scheduler: ConcurrentDispatchQueueScheduler(qos: .utility))
+            .subscribe(onNext: { [weak self, weak stream] _ in
+                log.debug("prepared event stream is expired")
+                self?.discard(stream)
+            })
+            .disposed(by: stream.expirationDisposeBag)
+        
+        stream.uploadDisposable = apiProvider.events(boundary: stream.boundary, httpHeaderFields: nil, inputStream: stream.eventSender.inputStream)
+            .subscribe(stream.subject)
+        log.debug("event stream is prepared: \(stream.boundary)")
+    }
+    
+    /**
+     Takes the prepared stream for the event.
+     
+     - Returns: `nil` if there's no prepared stream or the event cannot be sent through it.
+     */
+    func take(for event: Upstream.Event) -> PreparedStream? {
+        guard event.httpHeaderFields?.isEmpty ?? true else { return nil }
+        
+        var stream: PreparedStream?
+        _preparedStream.mutate {
+            stream = $0
+            $0 = nil
+        }
+        
+        guard let takenStream = stream else { return nil }
+        
+        // Authorization may be changed after the stream is opened.
+        guard takenStream.header == NuguApi.events.header else {
+            cancel(takenStream)
+            return nil
+        }
+        
+        takenStream.bind()
+        return takenStream
+    }
+    
+    func discard() {
+        discard(preparedStream)
+    }
+}
+
+// MARK: - PreparedStream
+
+extension EventStreamPool {
+    class PreparedStream {
+        let boundary: String
+        let eventSender: EventSender
+        fileprivate let header: [String: String]
+        fileprivate let subject = PublishSubject<MultiPartParser.Part>()
+        fileprivate var uploadDisposable: Disposable?
+        fileprivate var expirationDisposeBag = DisposeBag()
+        
+        fileprivate init(boundary: String, header: [String: String], watermark: DataBoundInputStream.Watermark?) {
+            self.boundary = boundary
+            self.header = header
+            eventSender = EventSender(boundary: boundary, watermark: watermark)
+        }
+        
+        /**
+         Parts of the response. Disposing the subscription disposes the upload stream.
+         
+         It must be subscribed before the event is sent. Because the parts received before the subscription are not replayed.
+         */
+        var parts: Observable<MultiPartParser.Part> {
+            // Subscription keeps the stream.
+            return Observable.create { observer in
+                let subscription = self.subject.subscribe(observer)
+                return Disposables.create {
+                    subscription.dispose()
+                    self.uploadDisposable?.dispose()
+                }
+            }
+        }
+        
+        /// Stops the expiration. The upload is kept until the subscription of `parts` is disposed.
+        fileprivate func bind() {
+            expirationDisposeBag = DisposeBag()
+        }
+    }
+}
+
+// MARK: - Private
+
+private extension EventStreamPool {
+    func discard(_ stream: PreparedStream?) {
+        guard let stream = stream else { return }
+        
+        var isDiscarded = false
+        _preparedStream.mutate {
+            guard $0 === stream else { return }
+            
+            $0 = nil
+            isDiscarded = true
+        }
+        
+        if isDiscarded {
+            cancel(stream)
+        }
+    }
+    
+    func cancel(_ stream: PreparedStream) {
+        apiProvider.cancelEvents(inputStream: stream.eventSender.inputStream)
+        stream.expirationDisposeBag = DisposeBag()
+        stream.uploadDisposable?.dispose()
+    }
+}
@@ -0,0 +1,223 @@
+//
+//  JSONStreamWriter.swift
+//  NuguCore
+//
+//  Created by agent on 2026/10/16.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/**
+ Single-pass JSON writer.
+ 
+ Values are written as UTF-8 bytes straight into one buffer without intermediate `Data` or `String`.
+ A member which cannot be serialized is rolled back and reported, so the rest of the document is still valid.
+ */
+struct JSONStreamWriter {
+    private(set) var data: Data
+    private var isFirstMember = true
+    
+    init(capacity: Int = 4 * 1024) {
+        data = Data(capacity: capacity)
+    }
+}
+
+// MARK: - Object
+
+extension JSONStreamWriter {
+    mutating func beginObject() {
+        data.append(Const.leftBrace)
+        isFirstMember = true
+    }
+    
+    mutating func endObject() {
+        data.append(Const.rightBrace)
+        isFirstMember = false
+    }
+    
+    /// Writes the key of member. The value must be written right after it.
+    mutating func writeKey(_ key: String) {
+        if isFirstMember == false {
+            data.append(Const.comma)
+        }
+        
+        writeString(key)
+        data.append(Const.colon)
+    }
+    
+    /// Writes a member whose value is a string.
+    mutating func writeMember(_ key: String, _ value: String) {
+        writeKey(key)
+        writeString(value)
+        isFirstMember = false
+    }
+    
+    /**
+     Writes a member whose value is JSON compatible object. (`String`, `NSNumber`, `Bool`, `Array`, `Dictionary` or `NSNull`)
+     
+     If the value cannot be serialized, the member is removed and the error is thrown.
+     */
+    mutating func writeMember(_ key: String, value: Any) throws {
+        let rollbackCount = data.count
+        let rollbackIsFirstMember = isFirstMember
+        
+        do {
+            writeKey(key)
+            try writeValue(value)
+            isFirstMember = false
+        } catch {
+            data.removeSubrange(rollbackCount...)
+            isFirstMember = rollbackIsFirstMember
+            throw error
+        }
+    }
+}
+
+// MARK: - Value
+
+private extension JSONStreamWriter {
+    mutating func writeValue(_ value: Any) throws {
+        let value = (value as? AnyHashable)?.base ?? value
+        
+        switch value {
+        case let string as String:
+            writeString(string)
+        case let number as NSNumber:
+            try writeNumber(number)
+        case let dictionary as [String: Any]:
+            data.append(Const.leftBrace)
+            var isFirst = true
+            for (key, element) in dictionary {
+                if isFirst == false {
+                    data.append(Const.comma)
+                }
+                isFirst = false
+                
+                writeString(key)
+                data.append(Const.colon)
+                try writeValue(element)
+            }
+            data.append(Const.rightBrace)
+        case let array as [Any]:
+            data.append(Const.leftBracket)
+            for (index, element) in array.enumerated() {
+                if 0 < index {
+                    data.append(Const.comma)
+                }
+                
+                try writeValue(element)
+            }
+            data.append(Const.rightBracket)
+        case is NSNull:
+            data.append(contentsOf: Const.nullLiteral)
+        default:
+            throw JSONStreamWriterError.invalidValue(value)
+        }
+    }
+    
+    mutating func writeNumber(_ number: NSNumber) throws {
+        if Self.isBoolean(number) {
+            data.append(contentsOf: number.boolValue ? Const.trueLiteral : Const.falseLiteral)
+            return
+        }
+        
+        guard number.doubleValue.isFinite else {
+            throw JSONStreamWriterError.invalidValue(number)
+        }
+        
+        data.append(contentsOf: number.stringValue.utf8)
+    }
+    
+    /// `Bool` is bridged to `NSNumber` whose class is distinct from the other numbers.
+    static func isBoolean(_ number: NSNumber) -> Bool {
+        #if canImport(CoreFoundation)
+        return ObjectIdentifier(type(of: number)) == Const.booleanType
+        #else
+        return String(cString: number.objCType) == "c"
+        #endif
+    }
+    
+    mutating func writeString(_ string: String) {
+        data.append(Const.quotationMark)
+        
+        var string = string
+        string.withUTF8 { bytes in
+            var runStartIndex = 0
+            for (index, byte) in bytes.enumerated() where byte < Const.space || byte == Const.quotationMark || byte == Const.backslash {
+                // Unescaped bytes are appended at once.
+                if runStartIndex < index {
+                    data.append(bytes.baseAddress! + runStartIndex, count: index - runStartIndex)
+                }
+                runStartIndex = index + 1
+                
+                data.append(Const.backslash)
+                switch byte {
+                case Const.quotationMark, Const.backslash:
+                    data.append(byte)
+                case Const.lineFeed:
+                    data.append(Const.lowerN)
+                case Const.carriageReturn:
+                    data.append(Const.lowerR)
+                case Const.tab:
+                    data.append(Const.lowerT)
+                default:
+                    data.append(contentsOf: String(format: "u%04x", byte).utf8)
+                }
+            }
+            
+            if runStartIndex < bytes.count {
+                data.append(bytes.baseAddress! + runStartIndex, count: bytes.count - runStartIndex)
+            }
+        }
+        
+        data.append(Const.quotationMark)
+    }
+}
+
+// MARK: - Const
+
+private extension JSONStreamWriter {
+    enum Const {
+        static let leftBrace = "{".data(using: .utf8)![0]
+        static let rightBrace = "}".data(using: .utf8)![0]
+        static let leftBracket = "[".data(using: .utf8)![0]
+        static let rightBracket = "]".data(using: .utf8)![0]
+        static let comma = ",".data(using: .utf8)![0]
+        static let colon = ":".data(using: .utf8)![0]
+        static let quotationMark = "\"".data(using: .utf8)![0]
+        static let backslash = "\\".data(using: .utf8)![0]
+        static let space = " ".data(using: .utf8)![0]
+        static let lineFeed = "\n".data(using: .utf8)![0]
+        static let carriageReturn = "\r".data(using: .utf8)![0]
+        static let tab = "\t".data(using: .utf8)![0]
+        static let lowerN = "n".data(using: .utf8)![0]
+        static let lowerR = "r".data(using: .utf8)![0]
+        static let lowerT = "t".data(using: .utf8)![0]
+        
+        static let nullLiteral = Array("null".utf8)
+        static let trueLiteral = Array("true".utf8)
+        static let falseLiteral = Array("false".utf8)
+        
+        static let booleanType = ObjectIdentifier(type(of: NSNumber(value: true)))
+    }
+}
+
+// MARK: - JSONStreamWriterError
+
+enum JSONStreamWriterError: Error {
+    /// The value is not JSON compatible object. (ex. NaN, Date, custom struct)
+    case invalidValue(Any)
+}
@@ -0,0 +1,180 @@
+//
+//  KeepAliveScheduler.swift
+//  NuguCore
+//
+//  Created by agent on 2026/10/16.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+import NuguUtils
+
+import RxSwift
+
+/**
+ Keeps the connection of server initiated directive alive adaptively.
+ 
+ - Ping is sent only when the connection has been idle for the most of the estimated idle timeout.
+   So it is skipped while events or directives use the connection.
+ - The idle timeout is learned from the disconnects observed after the connection was idle while the network was reachable.
+   It relaxes toward the default value whenever the ping succeeds.
+ - Failed ping is retried up to 3 times with exponential backoff.
+ - If the predicted idle cutoff has passed already (ex. the timer was suspended in background) or the retries of ping fail,
+   it requests reconnect before the next request stalls on the dead connection.
+ */
+class KeepAliveScheduler {
+    private let apiProvider: NuguApiProvider
+    private let pingRetryInterval: TimeInterval
+    private let currentDate: () -> Date
+    private let scheduler = ConcurrentDispatchQueueScheduler(qos: .utility)
+    private let reconnectSubject = PublishSubject<Void>()
+    @Atomic private var timerDisposable: Disposable?
+    @Atomic private(set) var estimatedIdleTimeout = Const.defaultIdleTimeout
+    
+    /**
+     - Parameters:
+        - pingRetryInterval: The delay before the first retry of failed ping. It is doubled on every retry.
+        - currentDate: The clock to measure the idle time. (ex. the clock advanced by test)
+     */
+    init(apiProvider: NuguApiProvider, pingRetryInterval: TimeInterval = 10, currentDate: @escaping () -> Date = { Date() }) {
+        self.apiProvider = apiProvider
+        self.pingRetryInterval = pingRetryInterval
+        self.currentDate = currentDate
+    }
+    
+    /// Emits when the connection is regarded as cut off.
+    var reconnectRequired: Observable<Void> {
+        return reconnectSubject
+    }
+    
+    func start() {
+        log.debug("keep-alive is started. estimated idle timeout: \(estimatedIdleTimeout)")
+        schedule()
+    }
+    
+    func stop() {
+        _timerDisposable.mutate {
+            $0?.dispose()
+            $0 = nil
+        }
+    }
+    
+    /**
+     Learns the idle timeout from the disconnect.
+     
+     The disconnect while the connection is used or the network is not reachable is ignored. It is not cut off by the server.
+     */
+    func connectionDidDisconnect() {
+        #if os(iOS)
+        guard NetworkReachabilityManager.shared.isReachable else { return }
+        #endif
+        
+        let idleTime = self.idleTime
+        guard Const.minIdleTimeout <= idleTime else { return }
+        
+        _estimatedIdleTimeout.mutate {
+            $0 = min(max(($0 + idleTime) / 2, Const.minIdleTimeout), Const.defaultIdleTimeout)
+        }
+        log.debug("disconnected after \(idleTime) sec idle. estimated idle timeout: \(estimatedIdleTimeout)")
+    }
+}
+
+// MARK: - Private
+
+private extension KeepAliveScheduler {
+    enum Const {
+        /// The server has kept the connection which is pinged every 180 ~ 300 seconds.
+        static let defaultIdleTimeout: TimeInterval = 300
+        static let minIdleTimeout: TimeInterval = 30
+        /// Ping is sent when the connection has been idle for this ratio of the estimated idle timeout.
+        static let pingRatio = 0.8
+        /// Ratio to relax the estimated idle timeout toward the default value on successful ping.
+        static let relaxationRatio = 0.1
+        static let minInterval: TimeInterval = 1
+        /// Same as the retry count of the ping which `ServerSentEventReceiver` used to send.
+        static let maxPingRetryCount = 3
+    }
+    
+    var idleTime: TimeInterval {
+        return currentDate().timeIntervalSince(apiProvider.lastActivityDate)
+    }
+    
+    func schedule() {
+        let delay = max(estimatedIdleTimeout * Const.pingRatio - idleTime, Const.minInterval)
+        let disposable = Observable<Int>.timer(.milliseconds(Int(delay * 1000)), scheduler: scheduler)
+            .subscribe(onNext: { [weak self] _ in
+                self?.keepAlive()
+            })
+        
+        _timerDisposable.mutate {
+            $0?.dispose()
+            $0 = disposable
+        }
+    }
+    
+    /// - Parameter retryCount: The number of failed ping in a row.
+    func keepAlive(retryCount: Int = 0) {
+        let idleTime = self.idleTime
+        
+        guard idleTime < estimatedIdleTimeout else {
+            log.debug("predicted idle cutoff has passed. idle: \(idleTime) sec")
+            reconnectSubject.onNext(())
+            return
+        }
+        
+        guard estimatedIdleTimeout * Const.pingRatio <= idleTime else {
+            // The connection was used recently. (ex. while waiting for the retry)
+            schedule()
+            return
+        }
+        
+        let disposable = apiProvider.ping
+            .subscribe(onCompleted: { [weak self] in
+                guard let self = self else { return }
+                
+                self._estimatedIdleTimeout.mutate {
+                    $0 += (Const.defaultIdleTimeout - $0) * Const.relaxationRatio
+                }
+                self.schedule()
+            }, onError: { [weak self] error in
+                log.error("Ping failed: \(error), retry count: \(retryCount)")
+                self?.retryPing(retryCount: retryCount)
+            })
+        
+        _timerDisposable.mutate {
+            $0?.dispose()
+            $0 = disposable
+        }
+    }
+    
+    func retryPing(retryCount: Int) {
+        guard retryCount < Const.maxPingRetryCount else {
+            reconnectSubject.onNext(())
+            return
+        }
+        
+        let delay = pingRetryInterval * pow(2, Double(retryCount))
+        let disposable = Observable<Int>.timer(.milliseconds(Int(delay * 1000)), scheduler: scheduler)
+            .subscribe(onNext: { [weak self] _ in
+                self?.keepAlive(retryCount: retryCount + 1)
+            })
+        
+        _timerDisposable.mutate {
+            $0?.dispose()
+            $0 = disposable
+        }
+    }
+}
@@ -20,6 +20,8 @@
 
 import Foundation
 
+import NuguUtils
+
 /// An enum that contains the data structures to be received from the server.
 public enum Downstream {
     /// A structure that contains payload and headers for the directive.
@@ -27,6 +29,8 @@ public enum Downstream {
         /// A structure that contains header fields for the directive.
         public let header: Header
         /// A JSON object that contains payload for the directive.
+        ///
+        /// It may be a slice of the received message. So its indices may not start from zero.
         public let payload: Data
         
         /// Creates an instance of an `Directive`.
@@ -47,14 +51,29 @@ public enum Downstream {
         public let header: Header
         /// The sequence number of attachment.
         public let seq: Int
-        /// The binary data.
-        public let content: Data
+        /// The binary data which may refer to the received network chunks without copying.
+        public let contentSegments: SegmentedData
         /// Indicates whether this attachment is the last one.
         public let isEnd: Bool
         /// The message identifier of the directive.
         public let parentMessageId: String
         /// The mime type of attachment.
         public let mediaType: String
+        /// Indicates whether all the bytes of this `seq` are received.
+        ///
+        /// It is `false` when `StreamDataRouter.isAttachmentStreamingEnabled` is set and the rest of bytes will follow with the same `seq`.
+        public let isCompleted: Bool
+        
+        /// The binary data.
+        ///
+        /// It is materialized from `contentSegments` whenever it is requested.
+        /// The bytes are copied unless the content is one segment starting from index zero,
+        /// and the attachment sliced out of the received chunk almost always is copied. Use `contentSegments` on the hot path.
+        public var content: Data {
+            let data = contentSegments.data
+            // Keep zero-based indices for the consumers subscripting from zero.
+            return data.startIndex == 0 ? data : data.subdata(in: data.startIndex..<data.endIndex)
+        }
         
         /// Creates an instance of an `Attachment`.
         /// - Parameters:
@@ -65,12 +84,26 @@ public enum Downstream {
         ///   - parentMessageId: The message identifier of the directive.
         ///   - mediaType: The mime type of attachment.
         public init(header: Header, seq: Int, content: Data, isEnd: Bool, parentMessageId: String, mediaType: String) {
+            self.init(header: header, seq: seq, contentSegments: SegmentedData(content), isEnd: isEnd, parentMessageId: parentMessageId, mediaType: mediaType)
+        }
+        
+        /// Creates an instance of an `Attachment`.
+        /// - Parameters:
+        ///   - header: A structure that contains header fields for the attachment.
+        ///   - seq: The sequence number of attachment.
+        ///   - contentSegments: The binary data which may refer to the received network chunks.
+        ///   - isEnd: Indicates whether this attachment is the last one.
+        ///   - parentMessageId: The message identifier of the directive.
+        ///   - mediaType: The mime type of attachment.
+        ///   - isCompleted: Indicates whether all the bytes of this `seq` are received.
+        public init(header: Header, seq: Int, contentSegments: SegmentedData, isEnd: Bool, parentMessageId: String, mediaType: String, isCompleted: Bool = true) {
             self.header = header
             self.seq = seq
-            self.content = content
+            self.contentSegments = contentSegments
             self.isEnd = isEnd
             self.parentMessageId = parentMessageId
             self.mediaType = mediaType
+            self.isCompleted = isCompleted
         }
     }
     
@@ -123,6 +156,45 @@ extension Downstream.Header {
     
 }
 
+// MARK: - Downstream.Attachment + Codable
+
+extension Downstream.Attachment {
+    private enum CodingKeys: String, CodingKey {
+        case header
+        case seq
+        case content
+        case isEnd
+        case parentMessageId
+        case mediaType
+        case isCompleted
+    }
+    
+    public init(from decoder: Decoder) throws {
+        let container = try decoder.container(keyedBy: CodingKeys.self)
+        self.init(
+            header: try container.decode(Downstream.Header.self, forKey: .header),
+            seq: try container.decode(Int.self, forKey: .seq),
+            contentSegments: SegmentedData(try container.decode(Data.self, forKey: .content)),
+            isEnd: try container.decode(Bool.self, forKey: .isEnd),
+            parentMessageId: try container.decode(String.self, forKey: .parentMessageId),
+            mediaType: try container.decode(String.self, forKey: .mediaType),
+            isCompleted: try container.decodeIfPresent(Bool.self, forKey: .isCompleted) ?? true
+        )
+    }
+    
+    public func encode(to encoder: Encoder) throws {
+        var container = encoder.container(keyedBy: CodingKeys.self)
+        try container.encode(header, forKey: .header)
+        try container.encode(seq, forKey: .seq)
+        // The slice is encoded as it is. Zero-based indices are not needed.
+        try container.encode(contentSegments.data, forKey: .content)
+        try container.encode(isEnd, forKey: .isEnd)
+        try container.encode(parentMessageId, forKey: .parentMessageId)
+        try container.encode(mediaType, forKey: .mediaType)
+        try container.encode(isCompleted, forKey: .isCompleted)
+    }
+}
+
 // MARK: - Downstream.Header + CustomStringConvertible
 
 /// :nodoc:
@@ -137,7 +209,7 @@ extension Downstream.Header: CustomStringConvertible {
 /// :nodoc:
 extension Downstream.Attachment: CustomStringConvertible {
     public var description: String {
-        return "\(header)), \(seq), \(isEnd)"
+        return "\(header)), \(seq), \(isEnd), \(isCompleted)"
     }
 }
 
@@ -21,7 +21,6 @@
 import Foundation
 
 import NuguUtils
-import NuguObjcUtils
 
 /// An enum that contains the data structures to be send to the server.
 public enum Upstream {
@@ -119,56 +118,87 @@ public enum Upstream {
 // MARK: - Upstream.Event
 
 extension Upstream.Event {
-    var headerString: String {
-        guard let data = try? JSONEncoder().encode(header),
-            let jsonString = String(data: data, encoding: .utf8) else {
-                return ""
-        }
+    /**
+     Writes the body of event part. `{ "context": { ... }, "event": { "header": { ... }, "payload": { ... } } }`
+     
+     Context is written straight from `contextPayload` without grouping it to the dictionaries.
+     */
+    func writeBody(to writer: inout JSONStreamWriter) {
+        writer.beginObject()
+        
+        writer.writeKey("context")
+        writeContext(to: &writer)
         
-        return jsonString
+        writer.writeKey("event")
+        writer.beginObject()
+        writer.writeKey("header")
+        writeHeader(to: &writer)
+        writer.writeKey("payload")
+        writeObject(payload.map { ($0.key, $0.value) }, to: &writer)
+        writer.endObject()
+        
+        writer.endObject()
+    }
+}
+
+private extension Upstream.Event {
+    func writeHeader(to writer: inout JSONStreamWriter) {
+        writer.beginObject()
+        writer.writeMember("namespace", header.namespace)
+        writer.writeMember("name", header.name)
+        writer.writeMember("version", header.version)
+        writer.writeMember("dialogRequestId", header.dialogRequestId)
+        writer.writeMember("messageId", header.messageId)
+        if let referrerDialogRequestId = header.referrerDialogRequestId {
+            writer.writeMember("referrerDialogRequestId", referrerDialogRequestId)
+        }
+        writer.endObject()
     }
     
-    var payloadString: String {
-        guard let data = try? JSONSerialization.data(withJSONObject: payload, options: []),
-            let payloadString = String(data: data, encoding: .utf8) else {
-                return ""
+    func writeContext(to writer: inout JSONStreamWriter) {
+        writer.beginObject()
+        
+        let capabilityContexts = contextPayload.filter { $0.contextType == .capability }
+        if capabilityContexts.isEmpty == false {
+            writer.writeKey("supportedInterfaces")
+            writeObject(members(of: capabilityContexts), to: &writer)
         }
         
-        return payloadString
+        writer.writeKey("client")
+        let clientContexts = contextPayload.filter { $0.contextType == .client }
+        let os = ContextInfo(contextType: .client, name: "os", payload: "iOS")
+        writeObject(members(of: [os] + clientContexts), to: &writer)
+        
+        writer.endObject()
     }
     
-    var contextString: String {
-        let contextDictionary = Dictionary(grouping: contextPayload, by: { $0.contextType })
-        let supportedInterfaces = contextDictionary[.capability]?.reduce(
-            into: [String: AnyHashable]()
-        ) { result, context in
-            result[context.name] = context.payload
+    /// The last payload wins when a name is duplicated, as the context dictionary did.
+    func members(of contexts: [ContextInfo]) -> [(String, AnyHashable)] {
+        var indexByName = [String: Int]()
+        var members = [(String, AnyHashable)]()
+        contexts.forEach { context in
+            if let index = indexByName[context.name] {
+                members[index].1 = context.payload
+            } else {
+                indexByName[context.name] = members.count
+                members.append((context.name, context.payload))
+            }
         }
-        var client: [String: AnyHashable] = ["os": "iOS"]
-        contextDictionary[.client]?.forEach({ (contextInfo) in
-            client[contextInfo.name] = contextInfo.payload
-        })
-        
-        let contextDict: [String: AnyHashable] = [
-            "supportedInterfaces": supportedInterfaces,
-            "client": client
-        ]
         
-        var contextString: String = ""
-        if let error = UnifiedErrorCatcher.try ({
+        return members
+    }
+    
+    /// Writes the members one by one. The member which cannot be serialized is omitted.
+    func writeObject(_ members: [(String, AnyHashable)], to writer: inout JSONStreamWriter) {
+        writer.beginObject()
+        members.forEach { key, value in
             do {
-                let data = try JSONSerialization.data(withJSONObject: contextDict.compactMapValues { $0 }, options: [])
-                contextString = String(data: data, encoding: .utf8) ?? ""
+                try writer.writeMember(key, value: value)
             } catch {
-                return error
+                log.error("\(key) includes unserializable object. error: \(error)")
             }
-            
-            return nil
-        }) {
-            log.error("context dictionary includes unserializable object. error: \(error)")
         }
-        
-        return contextString
+        writer.endObject()
     }
 }
 
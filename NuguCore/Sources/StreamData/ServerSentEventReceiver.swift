@@ -24,23 +24,26 @@ import RxSwift
 
 class ServerSentEventReceiver {
     private let apiProvider: NuguApiProvider
-    private var pingDisposable: Disposable?
+    private let keepAliveScheduler: KeepAliveScheduler
     private let stateSubject = PublishSubject<ServerSentEventReceiverState>()
     private let sseStateQueue = DispatchQueue(label: "com.sktelecom.romaine.core.server_sent_event_state")
-    private let disposeBag = DisposeBag()
     
     private(set) var state: ServerSentEventReceiverState = .unconnected {
         didSet {
             if oldValue != state {
                 log.debug("server side event receiver state changed from: \(oldValue) to: \(state)")
                 stateSubject.onNext(state)
-                state == .connected ? startPing() : stopPing()
+                if case .disconnected = state {
+                    keepAliveScheduler.connectionDidDisconnect()
+                }
+                state == .connected ? keepAliveScheduler.start() : keepAliveScheduler.stop()
             }
         }
     }
     
     init(apiProvider: NuguApiProvider) {
         self.apiProvider = apiProvider
+        keepAliveScheduler = KeepAliveScheduler(apiProvider: apiProvider)
     }
 
     var directive: Observable<MultiPartParser.Part> {
@@ -78,63 +81,9 @@ class ServerSentEventReceiver {
     var stateObserver: Observable<ServerSentEventReceiverState> {
         return stateSubject
     }
-}
-
-// MARK: - ping
-
-private extension ServerSentEventReceiver {
-    private enum Const {
-        static let minPingInterval = 180
-        static let maxPingInterval = 300
-        static let maxRetryCount = 3
-    }
-    
-    func startPing() {
-        log.debug("Try to start ping schedule")
-        
-        let randomPingTime = Int.random(in: Const.minPingInterval..<Const.maxPingInterval)
-        let pingDisposable = Observable<Int>.interval(.seconds(randomPingTime), scheduler: ConcurrentDispatchQueueScheduler(qos: .default))
-            .flatMap { [weak self] _ -> Completable in
-                guard let apiProvider = self?.apiProvider else {
-                    return Completable.error(NetworkError.badRequest)
-                }
-                
-                return apiProvider.ping
-        }
-        .retry {  (error: Observable<Error>) in
-            error
-                .enumerated()
-                .flatMap { (index, error) -> Observable<Int> in
-                    guard index < Const.maxRetryCount else {
-                        return Observable.error(error)
-                    }
-                    
-                    return Observable<Int>.timer(.seconds(0), period: .seconds(Int.random(in: 10..<30)), scheduler: ConcurrentDispatchQueueScheduler(qos: .default)).take(1)
-            }
-        }
-        .subscribe(onError: {
-            log.error("Ping failed: \($0)")
-        }, onDisposed: {
-            log.debug("Ping schedule for server initiated directive is cancelled")
-        })
-        
-        sseStateQueue.async { [weak self] in
-            guard let self else { return }
-            self.pingDisposable?.dispose()
-            self.pingDisposable = pingDisposable
-            pingDisposable.disposed(by: disposeBag)
-            log.debug("Ping schedule for server initiated directive is set. It will be triggered \(randomPingTime) seconds later.")
-        }
-    }
     
-    func stopPing() {
-        log.debug("Try to stop ping schedule")
-        
-        sseStateQueue.async { [weak self] in
-            guard let self else { return }
-            pingDisposable?.dispose()
-            pingDisposable = nil
-        }
-
+    /// Emits when the connection should be made again before the next request stalls on it.
+    var reconnectRequired: Observable<Void> {
+        return keepAliveScheduler.reconnectRequired
     }
 }
@@ -27,7 +27,7 @@ import RxSwift
 public class StreamDataRouter: StreamDataRoutable {
     private let notificationQueue = DispatchQueue(label: "com.sktelecom.romaine.stream_data_router_notificaiton_queue")
     
-    private let nuguApiProvider = NuguApiProvider()
+    private let nuguApiProvider: NuguApiProvider
     private let directiveSequencer: DirectiveSequenceable
     @Atomic private var eventSenders = [String: EventSender]()
     @Atomic private var eventDisposables = [String: Disposable]()
@@ -36,10 +36,252 @@ public class StreamDataRouter: StreamDataRoutable {
     private var serverInitiatedDirectiveDisposable: Disposable?
     private var serverInitiatedDirectiveStateDisposable: Disposable?
     private let disposeBag = DisposeBag()
+    private let eventStreamPool: EventStreamPool
+    private var trafficReplayDisposable: Disposable?
+    private let eventBatcher = EventBatcher(maxCount: Const.maxBatchedEventCount)
+    @Atomic private var batchableEventNames = Set<String>()
+    @Atomic private var eventBatchingWindowInterval: TimeInterval = 0
+    @Atomic private var deferrableEventNames = Set<String>()
+    @Atomic private var eventJournal: EventJournal?
+    @Atomic private var isEventJournalFlushing = false
+    /// The completions of the deferred events. The key is `messageId` of the event.
+    @Atomic private var deferredEventCompletions = [String: (StreamDataState) -> Void]()
+    @Atomic private var isEventStreamPreparationEnabled = false
+    @Atomic private var uploadWatermark: DataBoundInputStream.Watermark? = DataBoundInputStream.Watermark(
+        high: StreamDataRouter.Const.uploadHighWatermark,
+        low: StreamDataRouter.Const.uploadLowWatermark
+    )
+    /// The watermarks which are used instead of `uploadWatermark`. The key is `namespace.name` of the event.
+    @Atomic private var eventUploadWatermarks = [String: DataBoundInputStream.Watermark]()
     
-    public init(directiveSequencer: DirectiveSequenceable) {
+    /**
+     - Parameter directiveSequencer: The sequencer which handles the received directives.
+     - Parameter sessionConfiguration: Configuration of the sessions connecting to the device gateway.
+     Custom `protocolClasses` can serve the requests by a stand-in gateway, so the whole routing can be driven without the real server.
+     */
+    public init(directiveSequencer: DirectiveSequenceable, sessionConfiguration: URLSessionConfiguration = .ephemeral) {
+        nuguApiProvider = NuguApiProvider(sessionConfiguration: sessionConfiguration)
         serverInitiatedDirectiveReceiver = ServerSentEventReceiver(apiProvider: nuguApiProvider)
+        eventStreamPool = EventStreamPool(apiProvider: nuguApiProvider, idleTimeout: Const.eventStreamIdleTimeout)
         self.directiveSequencer = directiveSequencer
+        
+        nuguApiProvider.connectionReadySubject
+            .subscribe(onNext: { [weak self] timeToReady in
+                if self?.isEventStreamPreparationEnabled == true {
+                    self?.prepareEventStream()
+                }
+                
+                self?.flushEventJournal()
+                
+                self?.notificationQueue.async { [weak self] in
+                    self?.post(NuguCoreNotification.StreamDataRoute.ConnectionReady(timeToReady: timeToReady))
+                }
+            })
+            .disposed(by: disposeBag)
+        
+        serverInitiatedDirectiveReceiver.reconnectRequired
+            .subscribe(onNext: { [weak self] in
+                log.debug("reconnect server initiated directive receiver proactively")
+                self?.restartReceiveServerInitiatedDirective()
+            })
+            .disposed(by: disposeBag)
+        
+        eventBatcher.flushHandler = { [weak self] items in
+            self?.sendEvents(items)
+        }
+        
+        #if os(iOS)
+        NetworkReachabilityManager.shared.reachabilityChanged
+            .filter { $0 }
+            .subscribe(onNext: { [weak self] _ in
+                self?.flushEventJournal()
+            })
+            .disposed(by: disposeBag)
+        #endif
+    }
+}
+
+// MARK: - Options
+
+public extension StreamDataRouter {
+    /**
+     Deliver the body of attachment as fragments while it is being received.
+     
+     The attachment handler can receive several attachments which have the same `seq`.
+     And the last one has `isCompleted` flag. It is applied to the streams opened after it is set.
+     */
+    var isAttachmentStreamingEnabled: Bool {
+        get {
+            nuguApiProvider.isAttachmentStreamingEnabled
+        }
+        
+        set {
+            nuguApiProvider.isAttachmentStreamingEnabled = newValue
+        }
+    }
+    
+    /**
+     Accept the compressed body of directives and attachments.
+     
+     `Accept-Part-Encoding` is sent with the requests, and the part body which has `Content-Encoding` (gzip or deflate)
+     is inflated incrementally while it is being received. It is applied to the streams opened after it is set.
+     
+     - Important: `Accept-Part-Encoding` is not a standard header and the gateway is not confirmed to support it yet.
+     It is disabled by default. Enable it only with the server which compresses the part body by this header.
+     */
+    var isPartCompressionEnabled: Bool {
+        get {
+            nuguApiProvider.isPartCompressionEnabled
+        }
+        
+        set {
+            nuguApiProvider.isPartCompressionEnabled = newValue
+        }
+    }
+    
+    /**
+     Keep one upload stream opened before the event is ready.
+     
+     The prepared stream is bound to the next event and the new one is prepared after that.
+     It is also prepared when the connection to the resource server becomes ready.
+     The stream which is not used for a few seconds is discarded. Call `prepareEventStream()` when an event is expected soon. (ex. keyword detected)
+     */
+    var isEventStreamPoolEnabled: Bool {
+        get {
+            isEventStreamPreparationEnabled
+        }
+        
+        set {
+            isEventStreamPreparationEnabled = newValue
+            newValue ? prepareEventStream() : eventStreamPool.discard()
+        }
+    }
+    
+    /**
+     Open an upload stream before the event is ready if `isEventStreamPoolEnabled` is set.
+     */
+    func prepareEventStream() {
+        guard isEventStreamPreparationEnabled else { return }
+        
+        eventStreamPool.prepare(watermark: uploadWatermark)
+    }
+    
+    /**
+     Select the resource server by latency.
+     
+     All the servers from the registry are probed concurrently and the fastest one is connected.
+     The others are kept as the ranked fallback for retries and re-ranked in the background periodically.
+     It is applied when the server policies are resolved next time.
+     */
+    var isLatencyProbingEnabled: Bool {
+        get {
+            nuguApiProvider.isLatencyProbingEnabled
+        }
+        
+        set {
+            nuguApiProvider.isLatencyProbingEnabled = newValue
+        }
+    }
+    
+    /**
+     Watermarks of the bytes which are waiting to be uploaded in each event stream.
+     
+     `UploadBufferStateChanged` is posted when the buffer reaches the high watermark and when it drains to the low watermark.
+     So the producer of attachments can throttle, coalesce or drop the data while the upload is stalled.
+     Set nil to disable it. It is applied to the streams opened after it is set.
+     */
+    var uploadBufferWatermark: DataBoundInputStream.Watermark? {
+        get {
+            uploadWatermark
+        }
+        
+        set {
+            uploadWatermark = newValue
+        }
+    }
+    
+    /**
+     Sets the watermarks of the upload buffer for the streams of the event. The name is `namespace.name`. (ex. "ASR.Recognize")
+     
+     It is used instead of `uploadBufferWatermark`. So the producer of attachments can pick the threshold which fits the size of its data.
+     Set nil to use `uploadBufferWatermark` again. It is applied to the streams opened after it is set.
+     */
+    func setUploadBufferWatermark(_ watermark: DataBoundInputStream.Watermark?, forEvent eventName: String) {
+        _eventUploadWatermarks.mutate {
+            $0[eventName] = watermark
+        }
+    }
+    
+    /**
+     Events which can be held and sent together with others in one request. The element is `namespace.name`. (ex. "AudioPlayer.ProgressReportIntervalElapsed")
+     
+     Only the fire-and-forget events sent by `sendEvent(_:completion:)` without extra http header fields are batched.
+     The directives of response are delivered to the completion of the event which has the same `dialogRequestId`.
+     
+     - Note: It is empty by default. The device gateway is not confirmed to accept multiple events in one request yet.
+     */
+    var batchableEvents: Set<String> {
+        get {
+            batchableEventNames
+        }
+        
+        set {
+            batchableEventNames = newValue
+        }
+    }
+    
+    /**
+     The time to hold the batchable event for the others. Batching is disabled if it is `0`. (default)
+     
+     The held events are sent when the window of the first one is elapsed or the batch is full.
+     */
+    var eventBatchingWindow: TimeInterval {
+        get {
+            eventBatchingWindowInterval
+        }
+        
+        set {
+            eventBatchingWindowInterval = newValue
+            if newValue <= 0 {
+                eventBatcher.flush()
+            }
+        }
+    }
+    
+    /**
+     Events which can be deferred while the network is not reachable. The element is `namespace.name`. (ex. "AudioPlayer.PlaybackFinished")
+     
+     The deferred event is written to the journal in the caches directory. Its completion is held until the event is sent from the journal.
+     The journal is flushed when the network becomes reachable or the connection to the resource server becomes ready.
+     The events are sent in batches of up to 10 in one request, and they are removed from the journal after the response is finished.
+     The completion of the event dropped because the journal is full is called with `NetworkError.eventDropped`.
+     Only the events sent by `sendEvent(_:completion:)` without extra http header fields are deferred.
+     The context of the deferred event is the one when it is sent first.
+     */
+    var deferrableEvents: Set<String> {
+        get {
+            deferrableEventNames
+        }
+        
+        set {
+            deferrableEventNames = newValue
+            if newValue.isEmpty == false, eventJournal == nil {
+                let url = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask)[0]
+                    .appendingPathComponent(Const.eventJournalFilename)
+                do {
+                    let eventJournal = try EventJournal(url: url, capacity: Const.eventJournalCapacity)
+                    eventJournal.droppedEventsHandler = { [weak self] messageIds in
+                        messageIds.forEach {
+                            self?.completeDeferredEvent(messageId: $0, state: .error(NetworkError.eventDropped))
+                        }
+                    }
+                    self.eventJournal = eventJournal
+                    flushEventJournal()
+                } catch {
+                    log.error("failed to open event journal: \(error)")
+                }
+            }
+        }
     }
 }
 
@@ -118,6 +360,51 @@ public extension StreamDataRouter {
     }
 }
 
+// MARK: - Traffic capture
+
+public extension StreamDataRouter {
+    /**
+     Start to record the received directives and attachments to the trace file as they arrive.
+     
+     The raw chunks are recorded with the arrival time, so the trace can be replayed at the original timing.
+     - Parameter url: The trace file. It is overwritten.
+     */
+    func startTrafficCapture(to url: URL) throws {
+        let writer = try TrafficTrace.Writer(url: url)
+        stopTrafficCapture()
+        nuguApiProvider.trafficTraceWriter = writer
+        log.debug("traffic capture is started: \(url)")
+    }
+    
+    func stopTrafficCapture() {
+        let writer = nuguApiProvider.trafficTraceWriter
+        nuguApiProvider.trafficTraceWriter = nil
+        writer?.close()
+    }
+    
+    /**
+     Replay the trace recorded by `startTrafficCapture(to:)`.
+     
+     The parts are delivered to the `DirectiveSequencer` and notified in the same way as the received ones.
+     - Parameter url: The trace file.
+     - Parameter isRealTime: Replay at the original timing. Otherwise replay as fast as possible.
+     - Parameter completion: The completion handler. `finished` is passed when every record is replayed.
+     */
+    func replayTraffic(from url: URL, isRealTime: Bool, completion: ((StreamDataState) -> Void)? = nil) {
+        trafficReplayDisposable?.dispose()
+        trafficReplayDisposable = nuguApiProvider.replay(trace: url, isRealTime: isRealTime)
+            .subscribe(onNext: { [weak self] part in
+                self?.notifyMessage(with: part, completion: completion)
+            }, onError: { error in
+                log.error("replay failed: \(error)")
+                completion?(.error(error))
+            }, onCompleted: {
+                completion?(.finished)
+            })
+        trafficReplayDisposable?.disposed(by: disposeBag)
+    }
+}
+
 // MARK: - APIs for send event
 
 public extension StreamDataRouter {
@@ -127,14 +414,19 @@ public extension StreamDataRouter {
      This method is for the event which is not related attachment.
      */
     func sendEvent(_ event: Upstream.Event, completion: ((StreamDataState) -> Void)? = nil) {
-        sendStream(event) { [weak self] result in
-            // close stream automatically.
-            if case .sent = result {
-                self?.eventSenders[event.header.dialogRequestId]?.finish()
+        // The reachability is queried only for the deferrable event.
+        if let eventJournal = eventJournal, isDeferrable(event), isNetworkUnreachable {
+            log.debug("Event is deferred: \(event.header.dialogRequestId), \(event.header.namespace).\(event.header.name)")
+            eventJournal.append(event)
+            if let completion = completion {
+                _deferredEventCompletions.mutate {
+                    $0[event.header.messageId] = completion
+                }
             }
-
-            completion?(result)
+            return
         }
+        
+        sendEventWithoutDeferring(event, completion: completion)
     }
     
     /**
@@ -144,8 +436,23 @@ public extension StreamDataRouter {
      And It cannot be sent twice.
      */
     func sendStream(_ event: Upstream.Event, completion: ((StreamDataState) -> Void)? = nil) {
-        let boundary = HTTPConst.boundaryPrefix + event.header.dialogRequestId
-        let eventSender = EventSender(boundary: boundary)
+        // Bind the prepared stream to this event if it exists.
+        let preparedStream = eventStreamPool.take(for: event)
+        let boundary = preparedStream?.boundary ?? HTTPConst.boundaryPrefix + event.header.dialogRequestId
+        let watermark = eventUploadWatermarks["\(event.header.namespace).\(event.header.name)"] ?? uploadWatermark
+        let eventSender = preparedStream?.eventSender ?? EventSender(boundary: boundary, watermark: watermark)
+        // The prepared stream is opened with `uploadWatermark` before the event is known.
+        eventSender.inputStream.watermark = watermark
+        eventSender.bufferStateHandler = { [weak self] (isOverHighWatermark, bufferedBytes, durationOverHighWatermark) in
+            self?.notificationQueue.async { [weak self] in
+                self?.post(NuguCoreNotification.StreamDataRoute.UploadBufferStateChanged(
+                    dialogRequestId: event.header.dialogRequestId,
+                    isOverHighWatermark: isOverHighWatermark,
+                    bufferedBytes: bufferedBytes,
+                    durationOverHighWatermark: durationOverHighWatermark
+                ))
+            }
+        }
         _eventSenders.mutate {
             $0[event.header.dialogRequestId] = eventSender
         }
@@ -156,12 +463,12 @@ public extension StreamDataRouter {
             self?.post(NuguCoreNotification.StreamDataRoute.ToBeSentEvent(event: event))
         }
         
-        eventSender.send(event)
-        completion?(.sent)
-        
         // request event as multi part stream
+        // Prepared stream doesn't replay the parts. So subscribe it before sending the event.
+        let parts = preparedStream?.parts
+            ?? nuguApiProvider.events(boundary: boundary, httpHeaderFields: event.httpHeaderFields, inputStream: eventSender.inputStream)
         _eventDisposables.mutate {
-            $0[event.header.dialogRequestId] = nuguApiProvider.events(boundary: boundary, httpHeaderFields: event.httpHeaderFields, inputStream: eventSender.inputStream)
+            $0[event.header.dialogRequestId] = parts
                 .subscribe(onNext: { [weak self] (part) in
                     self?.notifyMessage(with: part, completion: completion)
                 }, onError: { [weak self] (error) in
@@ -196,6 +503,14 @@ public extension StreamDataRouter {
                     }
                 })
         }
+        
+        eventSender.send(event)
+        completion?(.sent)
+        
+        // Refill the pool for the next event.
+        if isEventStreamPreparationEnabled, preparedStream != nil {
+            eventStreamPool.prepare(watermark: uploadWatermark)
+        }
     }
     
     /**
@@ -232,11 +547,190 @@ public extension StreamDataRouter {
      Cancel sending event.
      */
     func cancelEvent(dialogRequestId: String) {
+        // The event held for the batch is not sent at all.
+        if eventBatcher.remove(dialogRequestId: dialogRequestId) != nil {
+            return
+        }
+        
         eventSenders[dialogRequestId]?.finish()
         eventDisposables[dialogRequestId]?.dispose()
     }
 }
 
+// MARK: - Event journal
+
+private extension StreamDataRouter {
+    var isNetworkUnreachable: Bool {
+        #if os(iOS)
+        return NetworkReachabilityManager.shared.isReachable == false
+        #else
+        return false
+        #endif
+    }
+    
+    func isDeferrable(_ event: Upstream.Event) -> Bool {
+        return (event.httpHeaderFields?.isEmpty ?? true)
+            && deferrableEventNames.contains("\(event.header.namespace).\(event.header.name)")
+    }
+    
+    /// Sends the event right away. The event sent from the journal is not deferred again.
+    func sendEventWithoutDeferring(_ event: Upstream.Event, completion: ((StreamDataState) -> Void)?) {
+        if 0 < eventBatchingWindowInterval,
+            event.httpHeaderFields?.isEmpty ?? true,
+            batchableEventNames.contains("\(event.header.namespace).\(event.header.name)") {
+            log.debug("Event is held to be batched: \(event.header.dialogRequestId), \(event.header.namespace).\(event.header.name)")
+            eventBatcher.append(event, window: eventBatchingWindowInterval, completion: completion)
+            return
+        }
+        
+        sendStream(event) { [weak self] result in
+            // close stream automatically.
+            if case .sent = result {
+                self?.eventSenders[event.header.dialogRequestId]?.finish()
+            }
+            
+            completion?(result)
+        }
+    }
+    
+    /// Sends the deferred events in batches.
+    func flushEventJournal() {
+        guard let eventJournal = eventJournal, isNetworkUnreachable == false else { return }
+        
+        var isFlushing = false
+        _isEventJournalFlushing.mutate {
+            isFlushing = $0
+            $0 = true
+        }
+        guard isFlushing == false else { return }
+        
+        resendFirstEvents(of: eventJournal)
+    }
+    
+    /**
+     Sends the oldest events in the journal in one request, and the next ones after its response is finished.
+     
+     The events are removed from the journal only after the response is finished.
+     The events which fail by the network error are kept and sent again when the journal is flushed next time.
+     */
+    func resendFirstEvents(of eventJournal: EventJournal) {
+        let events = isNetworkUnreachable ? [] : eventJournal.prefix(Const.maxBatchedEventCount)
+        guard events.isEmpty == false else {
+            isEventJournalFlushing = false
+            return
+        }
+        
+        log.debug("resend \(events.count) deferred events")
+        let items = events.map { event -> EventBatcher.Item in
+            let messageId = event.header.messageId
+            return (event: event, completion: { [weak self] state in
+                switch state {
+                case .error(let error) where error is URLError:
+                    // The completion is held until the event is sent again.
+                    break
+                case .error, .finished:
+                    self?.completeDeferredEvent(messageId: messageId, state: state)
+                default:
+                    self?.deferredEventCompletions[messageId]?(state)
+                }
+            })
+        }
+        
+        sendEvents(items) { [weak self] state in
+            guard let self = self else { return }
+            
+            if case .error(let error) = state, error is URLError {
+                log.error("deferred events are failed: \(error)")
+                self.isEventJournalFlushing = false
+                return
+            }
+            
+            eventJournal.removeFirst(messageIds: events.map { $0.header.messageId })
+            self.resendFirstEvents(of: eventJournal)
+        }
+    }
+    
+    func completeDeferredEvent(messageId: String, state: StreamDataState) {
+        var completion: ((StreamDataState) -> Void)?
+        _deferredEventCompletions.mutate {
+            completion = $0.removeValue(forKey: messageId)
+        }
+        
+        completion?(state)
+    }
+}
+
+// MARK: - Event batch
+
+private extension StreamDataRouter {
+    /**
+     Sends the events as multiple event parts in one request.
+     
+     - Parameter batchCompletion: Called once when the response is finished or failed, after the completions of the events.
+     */
+    func sendEvents(_ items: [EventBatcher.Item], batchCompletion: ((StreamDataState) -> Void)? = nil) {
+        let boundary = HTTPConst.boundaryPrefix + UUID().uuidString
+        let eventSender = EventSender(boundary: boundary, watermark: uploadWatermark)
+        log.debug("Batched events: \(items.map { "\($0.event.header.namespace).\($0.event.header.name)" }), boundary: \(boundary)")
+        
+        // Deliver the directive to the event which requested it.
+        let completion: (StreamDataState) -> Void = { state in
+            switch state {
+            case .received(let directive):
+                items
+                    .filter { $0.event.header.dialogRequestId == directive.header.dialogRequestId }
+                    .forEach { $0.completion?(state) }
+            default:
+                items.forEach { $0.completion?(state) }
+            }
+        }
+        
+        let notifySentEvents: (Error?) -> Void = { [weak self] error in
+            self?.notificationQueue.async { [weak self] in
+                items.forEach { self?.post(NuguCoreNotification.StreamDataRoute.SentEvent(event: $0.event, error: error)) }
+            }
+        }
+        
+        items.forEach { item in
+            notificationQueue.async { [weak self] in
+                self?.post(NuguCoreNotification.StreamDataRoute.ToBeSentEvent(event: item.event))
+            }
+        }
+        
+        _eventDisposables.mutate {
+            $0[boundary] = nuguApiProvider.events(boundary: boundary, httpHeaderFields: nil, inputStream: eventSender.inputStream)
+                .subscribe(onNext: { [weak self] (part) in
+                    self?.notifyMessage(with: part, completion: completion)
+                }, onError: { (error) in
+                    log.error("\(error.localizedDescription)")
+                    notifySentEvents(error)
+                    completion(.error(error))
+                    batchCompletion?(.error(error))
+                }, onCompleted: { [weak self] in
+                    guard let self = self else { return }
+                    
+                    notifySentEvents(nil)
+                    
+                    // Restart server initiated directive receiver if it was disconnected with error
+                    if case .disconnected = self.serverInitiatedDirectiveReceiver.state {
+                        self.startReceiveServerInitiatedDirective(completion: self.serverInitiatedDirectiveCompletion)
+                    }
+                    
+                    completion(.finished)
+                    batchCompletion?(.finished)
+                }, onDisposed: { [weak self] in
+                    self?._eventDisposables.mutate {
+                        $0[boundary] = nil
+                    }
+                })
+        }
+        
+        eventSender.send(items.map { $0.event })
+        eventSender.finish()
+        completion(.sent)
+    }
+}
+
 // MARK: - private
 
 extension StreamDataRouter {
@@ -247,15 +741,13 @@ extension StreamDataRouter {
      But we can process every single directive separately using this method
      */
     private func notifyMessage(with part: MultiPartParser.Part, completion: ((StreamDataState) -> Void)? = nil) {
-        if let contentType = part.header["Content-Type"], contentType.contains("application/json") {
-            guard let bodyDictionary = try? JSONSerialization.jsonObject(with: part.body, options: []) as? [String: AnyHashable],
-                let directiveArray = bodyDictionary["directives"] as? [[String: AnyHashable]] else {
-                    log.error("Decode Message failed")
-                    completion?(.error(NetworkError.invalidMessageReceived))
-                    return
+        if let contentType = part.header[.contentType], contentType.contains(HTTPConst.jsonContentType) {
+            guard let directives = try? DirectiveDecoder.decode(part.body) else {
+                log.error("Decode Message failed")
+                completion?(.error(NetworkError.invalidMessageReceived))
+                return
             }
             
-            let directives = directiveArray.compactMap(Downstream.Directive.init)
             post(NuguCoreNotification.StreamDataRoute.ReceivedDirectives(directives: directives))
             
             directives.forEach { directive in
@@ -268,7 +760,7 @@ extension StreamDataRouter {
                 completion?(.received(part: directive))
                 serverInitiatedDirectiveCompletion?(.received(part: directive))
             }
-        } else if let attachment = Downstream.Attachment(headerDictionary: part.header, body: part.body) {
+        } else if let attachment = Downstream.Attachment(multiPartHeader: part.header, body: part.body, isCompleted: part.isCompleted) {
             log.debug("Attachment: \(attachment.header.dialogRequestId), \(attachment.header.type)")
             self.notificationQueue.async { [weak self] in
                 self?.post(NuguCoreNotification.StreamDataRoute.ReceivedAttachment(attachment: attachment))
@@ -284,17 +776,25 @@ extension StreamDataRouter {
 // MARK: - Downstream.Attachment initializer
 
 private extension Downstream.Attachment {
-    init?(headerDictionary: [String: String], body: Data) {
-        guard let header = Downstream.Header(headerDictionary: headerDictionary),
-            let fileInfo = headerDictionary["Filename"]?.split(separator: ";"),
+    init?(multiPartHeader: MultiPartHeader, body: SegmentedData, isCompleted: Bool) {
+        guard let header = Downstream.Header(multiPartHeader: multiPartHeader),
+            let fileInfo = multiPartHeader[.filename]?.split(separator: ";"),
             fileInfo.count == 2,
             let fileSequence = Int(String(fileInfo[0])),
-            let mediaType = headerDictionary["Content-Type"],
-            let parentMessageId = headerDictionary["Parent-Message-Id"] else {
+            let mediaType = multiPartHeader[.contentType],
+            let parentMessageId = multiPartHeader[.parentMessageId] else {
                 return nil
         }
         
-        self.init(header: header, seq: fileSequence, content: body, isEnd: fileInfo[1] == "end", parentMessageId: parentMessageId, mediaType: mediaType)
+        self.init(
+            header: header,
+            seq: fileSequence,
+            contentSegments: body,
+            isEnd: fileInfo[1] == "end" && isCompleted,
+            parentMessageId: parentMessageId,
+            mediaType: mediaType,
+            isCompleted: isCompleted
+        )
     }
 }
 
@@ -317,12 +817,12 @@ public extension Downstream.Directive {
 // MARK: - Downstream.Header initializer
 
 private extension Downstream.Header {
-    init?(headerDictionary: [String: String]) {
-        guard let namespace = headerDictionary["Namespace"],
-            let name = headerDictionary["Name"],
-            let dialogRequestId = headerDictionary["Dialog-Request-Id"],
-            let version = headerDictionary["Version"],
-            let messageId = headerDictionary["Message-Id"] else {
+    init?(multiPartHeader: MultiPartHeader) {
+        guard let namespace = multiPartHeader[.namespace],
+            let name = multiPartHeader[.name],
+            let dialogRequestId = multiPartHeader[.dialogRequestId],
+            let version = multiPartHeader[.version],
+            let messageId = multiPartHeader[.messageId] else {
                 return nil
         }
         
@@ -339,6 +839,8 @@ extension Notification.Name {
     static let streamDataEventWillSend = Notification.Name("com.sktelecom.romaine.notification.name.stream_data_event_will_send")
     static let streamDataEventDidSend = Notification.Name("com.sktelecom.romaine.notification.name.stream_data_event_did_send")
     static let streamDataAttachmentDidSend = Notification.Name("com.sktelecom.romaine.notification.name.stream_data_attachment_did_send")
+    static let streamDataConnectionDidBecomeReady = Notification.Name("com.sktelecom.romaine.notification.name.stream_data_connection_did_become_ready")
+    static let streamDataUploadBufferStateDidChange = Notification.Name("com.sktelecom.romaine.notification.name.stream_data_upload_buffer_state_did_change")
 }
 
 public extension NuguCoreNotification {
@@ -413,6 +915,57 @@ public extension NuguCoreNotification {
             }
         }
         
+        /// Posted when the connection to the resource server is warmed up after the server policies are resolved.
+        public struct ConnectionReady: TypedNotification {
+            public static var name: Notification.Name = .streamDataConnectionDidBecomeReady
+            /// Time taken from resolving the server policies to the connection ready.
+            public let timeToReady: TimeInterval
+            
+            public static func make(from: [String: Any]) -> ConnectionReady? {
+                guard let timeToReady = from["timeToReady"] as? TimeInterval else { return nil }
+                
+                return ConnectionReady(timeToReady: timeToReady)
+            }
+        }
+        
+        /// Posted when the upload buffer of event stream reaches the high watermark and when it drains to the low watermark.
+        public struct UploadBufferStateChanged: TypedNotification {
+            public static var name: Notification.Name = .streamDataUploadBufferStateDidChange
+            public let dialogRequestId: String
+            public let isOverHighWatermark: Bool
+            public let bufferedBytes: Int
+            /// Time spent over the high watermark. It is set only when the buffer drains to the low watermark.
+            public let durationOverHighWatermark: TimeInterval?
+            
+            public static func make(from: [String: Any]) -> UploadBufferStateChanged? {
+                guard let dialogRequestId = from["dialogRequestId"] as? String,
+                    let isOverHighWatermark = from["isOverHighWatermark"] as? Bool,
+                    let bufferedBytes = from["bufferedBytes"] as? Int else { return nil }
+                
+                let durationOverHighWatermark = from["durationOverHighWatermark"] as? TimeInterval
+                return UploadBufferStateChanged(
+                    dialogRequestId: dialogRequestId,
+                    isOverHighWatermark: isOverHighWatermark,
+                    bufferedBytes: bufferedBytes,
+                    durationOverHighWatermark: durationOverHighWatermark
+                )
+            }
+        }
+        
         public typealias ServerInitiatedDirectiveReceiverState = ServerSentEventReceiverState
     }
 }
+
+// MARK: - Const
+
+private extension StreamDataRouter {
+    enum Const {
+        static let uploadHighWatermark = 64 * 1024
+        static let uploadLowWatermark = 16 * 1024
+        /// Shorter than the request timeout of `NuguApiProvider`.
+        static let eventStreamIdleTimeout = RxTimeInterval.seconds(7)
+        static let maxBatchedEventCount = 10
+        static let eventJournalFilename = "nugu_event_journal"
+        static let eventJournalCapacity = 1024 * 1024
+    }
+}
@@ -0,0 +1,143 @@
+//
+//  ByteSearcherTests.swift
+//  NuguCoreTests
+//
+//  Created by agent on 2026/10/17.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+
+@testable import NuguCore
+
+final class ByteSearcherTests: XCTestCase {
+    func testFirstIndex() {
+        let searcher = ByteSearcher("--boundary")
+        
+        withBytes("preamble\r\n--boundary\r\n--boundary--") { bytes in
+            XCTAssertEqual(searcher.firstIndex(in: bytes), 10)
+            XCTAssertEqual(searcher.firstIndex(in: bytes, from: 11), 22)
+            XCTAssertNil(searcher.firstIndex(in: bytes, from: 23))
+        }
+        withBytes("--bound") { bytes in
+            XCTAssertNil(searcher.firstIndex(in: bytes))
+        }
+        withBytes("") { bytes in
+            XCTAssertNil(searcher.firstIndex(in: bytes))
+        }
+    }
+    
+    func testFirstIndexOfSingleByte() {
+        let searcher = ByteSearcher(":")
+        
+        withBytes("Content-Type: application/json") { bytes in
+            XCTAssertEqual(searcher.firstIndex(in: bytes), 12)
+            XCTAssertNil(searcher.firstIndex(in: bytes, from: 13))
+        }
+    }
+    
+    func testMatchOfNeedleSplitAtEveryIndex() {
+        let searcher = ByteSearcher("--boundary")
+        let message = Array("body--boundary\r\n".utf8)
+        
+        for splitIndex in 0...message.count {
+            let head = Array(message[..<splitIndex])
+            let tail = Array(message[splitIndex...])
+            
+            var endIndex: Int?
+            var matched = 0
+            head.withUnsafeBufferPointer { bytes in
+                switch searcher.match(in: bytes, from: 0, matched: 0) {
+                case .found(let foundEndIndex):
+                    endIndex = foundEndIndex
+                case .partial(let partialMatched):
+                    matched = partialMatched
+                }
+            }
+            if endIndex == nil {
+                tail.withUnsafeBufferPointer { bytes in
+                    guard case let .found(foundEndIndex) = searcher.match(in: bytes, from: 0, matched: matched) else { return }
+                    
+                    endIndex = head.count + foundEndIndex
+                }
+            }
+            
+            XCTAssertEqual(endIndex, 14, "split at \(splitIndex)")
+        }
+    }
+    
+    func testMatchResumesWithOverlappedPrefix() {
+        let searcher = ByteSearcher("aab")
+        
+        withBytes("xaa") { bytes in
+            XCTAssertEqual(searcher.match(in: bytes, from: 0, matched: 0), .partial(matched: 2))
+        }
+        // "aa" + "a" is not matched. But the last "aa" is still the prefix.
+        withBytes("ab") { bytes in
+            XCTAssertEqual(searcher.match(in: bytes, from: 0, matched: 2), .found(endIndex: 2))
+        }
+        withBytes("xyz") { bytes in
+            XCTAssertEqual(searcher.match(in: bytes, from: 0, matched: 2), .partial(matched: 0))
+        }
+    }
+    
+    func testScalarFallbackMatchesPlatformSearch() {
+        let bytes = (0..<4096).map { UInt8(truncatingIfNeeded: $0 &* 31 &+ $0 / 7) }
+        
+        bytes.withUnsafeBufferPointer { bytes in
+            for byte in [UInt8(0x00), 0x0d, 0x2d, 0xff] {
+                for startIndex in stride(from: 0, through: bytes.count, by: 97) {
+                    XCTAssertEqual(
+                        ByteSearcher.firstIndex(of: byte, in: bytes, from: startIndex),
+                        ByteSearcher.scalarFirstIndex(of: byte, in: bytes, from: startIndex),
+                        "byte: \(byte), start: \(startIndex)"
+                    )
+                }
+            }
+        }
+    }
+    
+    func testBoundarySearchThroughput() {
+        let searcher = ByteSearcher("\r\n--this-is-a-boundary")
+        // Audio attachment is close to the random bytes.
+        var haystack = (0..<(16 * 1024 * 1024)).map { UInt8(truncatingIfNeeded: ($0 &* 2_654_435_761) >> 13) }
+        haystack.replaceSubrange((haystack.count - searcher.needle.count)..., with: searcher.needle)
+        
+        haystack.withUnsafeBufferPointer { bytes in
+            measure {
+                XCTAssertEqual(searcher.firstIndex(in: bytes), bytes.count - searcher.needle.count)
+            }
+        }
+    }
+    
+    func testCarriageReturnSearchThroughput() {
+        var haystack = [UInt8](repeating: UInt8(ascii: "a"), count: 16 * 1024 * 1024)
+        haystack[haystack.count - 1] = HTTPConst.carriageReturn
+        
+        haystack.withUnsafeBufferPointer { bytes in
+            measure {
+                XCTAssertEqual(ByteSearcher.firstIndex(of: HTTPConst.carriageReturn, in: bytes), bytes.count - 1)
+            }
+        }
+    }
+}
+
+// MARK: - Private
+
+private extension ByteSearcherTests {
+    func withBytes(_ string: String, _ body: (UnsafeBufferPointer<UInt8>) -> Void) {
+        Array(string.utf8).withUnsafeBufferPointer(body)
+    }
+}
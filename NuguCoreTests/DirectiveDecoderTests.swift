@@ -0,0 +1,169 @@
+//
+//  DirectiveDecoderTests.swift
+//  NuguCoreTests
+//
+//  Created by agent on 2026/10/17.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+
+import NuguUtils
+@testable import NuguCore
+
+final class DirectiveDecoderTests: XCTestCase {
+    private let body = """
+    {
+      "directives": [
+        {
+          "header": {
+            "namespace": "TTS",
+            "name": "Speak",
+            "dialogRequestId": "dialog-request-id",
+            "messageId": "message-id-0",
+            "version": "1.3",
+            "messageTimestamp": 1234
+          },
+          "payload": { "text": "escaped \\"text\\" {not a brace}", "list": [1, {"nested": null}] }
+        },
+        {
+          "header": {
+            "namespace": "Text\\u0053ource",
+            "name": "TextSource",
+            "dialogRequestId": "dialog-request-id",
+            "messageId": "message-id-1",
+            "version": "1.0",
+            "messageTimestamp": null
+          },
+          "payload": {}
+        }
+      ],
+      "unknown": { "directives": "ignored" }
+    }
+    """
+    
+    func testDecode() throws {
+        let directives = try DirectiveDecoder.decode(Data(body.utf8))
+        
+        XCTAssertEqual(directives.count, 2)
+        XCTAssertEqual(directives[0].header.namespace, "TTS")
+        XCTAssertEqual(directives[0].header.name, "Speak")
+        XCTAssertEqual(directives[0].header.messageId, "message-id-0")
+        XCTAssertEqual(directives[0].header.version, "1.3")
+        XCTAssertEqual(directives[0].header.messageTimestamp, 1234)
+        XCTAssertEqual(directives[0].payloadDictionary?["text"] as? String, "escaped \"text\" {not a brace}")
+        XCTAssertEqual(directives[1].header.namespace, "TextSource")
+        XCTAssertNil(directives[1].header.messageTimestamp)
+        XCTAssertEqual(directives[1].payload, Data("{}".utf8))
+    }
+    
+    func testPayloadStartsFromIndexZero() throws {
+        let directives = try DirectiveDecoder.decode(SegmentedData(Data(body.utf8)))
+        
+        for directive in directives {
+            XCTAssertEqual(directive.payload.startIndex, 0)
+            XCTAssertEqual(directive.payload[0], UInt8(ascii: "{"))
+        }
+    }
+    
+    func testDecodeSegmentedBody() throws {
+        let bytes = Data(body.utf8)
+        var segmentedBody = SegmentedData()
+        stride(from: 0, to: bytes.count, by: 7).forEach {
+            segmentedBody.append(bytes[$0..<min($0 + 7, bytes.count)])
+        }
+        
+        let directives = try DirectiveDecoder.decode(segmentedBody)
+        XCTAssertEqual(directives.map { $0.header.messageId }, ["message-id-0", "message-id-1"])
+    }
+    
+    func testInvalidDirectiveIsOmitted() throws {
+        let body = """
+        {"directives": [
+          {"header": {"namespace": "TTS", "name": "Speak", "dialogRequestId": "d", "messageId": "m", "version": 1}, "payload": {}},
+          {"header": {"namespace": "TTS", "name": "Speak", "dialogRequestId": "d", "messageId": "m", "version": "1.3"}},
+          {"header": {"namespace": "TTS", "name": "Stop", "dialogRequestId": "d", "messageId": "m", "version": "1.3"}, "payload": {}}
+        ]}
+        """
+        
+        let directives = try DirectiveDecoder.decode(Data(body.utf8))
+        XCTAssertEqual(directives.map { $0.header.name }, ["Stop"])
+    }
+    
+    func testMalformedBodyIsThrown() {
+        XCTAssertThrowsError(try DirectiveDecoder.decode(Data(#"{"unknown": []}"#.utf8)))
+        XCTAssertThrowsError(try DirectiveDecoder.decode(Data(#"{"directives": [{"header": {}"#.utf8)))
+        XCTAssertThrowsError(try DirectiveDecoder.decode(Data()))
+    }
+    
+    // MARK: Recorded directives
+    
+    func testRecordedDirectivesMatchLegacyDecoding() throws {
+        for body in [DirectiveFixtures.displayTemplate, DirectiveFixtures.audioPlayerPlaylist] {
+            let directives = try DirectiveDecoder.decode(body)
+            let legacyDirectives = try legacyDecode(body)
+            
+            XCTAssertEqual(directives.count, legacyDirectives.count)
+            zip(directives, legacyDirectives).forEach { directive, legacyDirective in
+                XCTAssertEqual(directive.header.type, legacyDirective.header.type)
+                XCTAssertEqual(directive.header.messageId, legacyDirective.header.messageId)
+                XCTAssertEqual(directive.header.messageTimestamp, legacyDirective.header.messageTimestamp)
+                XCTAssertEqual(directive.payloadDictionary, legacyDirective.payloadDictionary)
+            }
+        }
+    }
+    
+    func testDisplayTemplateDecodingPerformance() {
+        measureDecoding(DirectiveFixtures.displayTemplate, decode: DirectiveDecoder.decode)
+    }
+    
+    func testDisplayTemplateLegacyDecodingPerformance() {
+        measureDecoding(DirectiveFixtures.displayTemplate, decode: legacyDecode)
+    }
+    
+    func testAudioPlayerPlaylistDecodingPerformance() {
+        measureDecoding(DirectiveFixtures.audioPlayerPlaylist, decode: DirectiveDecoder.decode)
+    }
+    
+    func testAudioPlayerPlaylistLegacyDecodingPerformance() {
+        measureDecoding(DirectiveFixtures.audioPlayerPlaylist, decode: legacyDecode)
+    }
+}
+
+// MARK: - Private
+
+private extension DirectiveDecoderTests {
+    /// Decodes as `StreamDataRouter` did before `DirectiveDecoder`.
+    func legacyDecode(_ body: Data) throws -> [Downstream.Directive] {
+        guard let bodyDictionary = try JSONSerialization.jsonObject(with: body, options: []) as? [String: AnyHashable],
+            let directiveArray = bodyDictionary["directives"] as? [[String: AnyHashable]] else {
+                throw NetworkError.invalidMessageReceived
+        }
+        
+        return directiveArray.compactMap(Downstream.Directive.init)
+    }
+    
+    func measureDecoding(_ body: Data, decode: (Data) throws -> [Downstream.Directive]) {
+        measure {
+            for _ in 0..<Const.decodingCount {
+                XCTAssertNoThrow(try decode(body))
+            }
+        }
+    }
+    
+    enum Const {
+        static let decodingCount = 500
+    }
+}
@@ -0,0 +1,148 @@
+//
+//  EventJournalTests.swift
+//  NuguCoreTests
+//
+//  Created by agent on 2026/10/17.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+
+@testable import NuguCore
+
+final class EventJournalTests: XCTestCase {
+    private var url: URL!
+    
+    override func setUp() {
+        super.setUp()
+        url = FileManager.default.temporaryDirectory.appendingPathComponent("event_journal_\(UUID().uuidString)")
+    }
+    
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: url)
+        super.tearDown()
+    }
+    
+    func testAppendedEventsAreKeptUntilRemoved() throws {
+        let journal = try EventJournal(url: url, capacity: 64 * 1024)
+        let events = (0..<5).map { event(index: $0) }
+        events.forEach { journal.append($0) }
+        
+        let firstEvents = journal.prefix(3)
+        XCTAssertEqual(firstEvents.map { $0.header.messageId }, events[0..<3].map { $0.header.messageId })
+        XCTAssertEqual(firstEvents.first?.payload["index"] as? Int, 0)
+        XCTAssertEqual(firstEvents.first?.contextPayload.first { $0.name == "AudioPlayer" }?.payload as? [String: String], ["version": "1.6"])
+        
+        // Not removed until the response is finished.
+        XCTAssertEqual(journal.prefix(3).count, 3)
+        
+        journal.removeFirst(messageIds: firstEvents.map { $0.header.messageId })
+        XCTAssertEqual(journal.prefix(10).map { $0.header.messageId }, events[3...].map { $0.header.messageId })
+    }
+    
+    func testOnlyOldestEventsAreRemoved() throws {
+        let journal = try EventJournal(url: url, capacity: 64 * 1024)
+        let events = (0..<3).map { event(index: $0) }
+        events.forEach { journal.append($0) }
+        
+        // The second event is not the oldest one. (ex. The first one was dropped and appended again)
+        journal.removeFirst(messageIds: [events[1].header.messageId])
+        XCTAssertEqual(journal.prefix(10).count, 3)
+        
+        journal.removeFirst(messageIds: events.map { $0.header.messageId })
+        XCTAssertTrue(journal.prefix(10).isEmpty)
+    }
+    
+    func testCompactionDropsOldestEvents() throws {
+        let eventSize = try recordSize(of: event(index: 0))
+        // The header and about 4 records.
+        let journal = try EventJournal(url: url, capacity: 16 + eventSize * 4 + eventSize / 2)
+        var droppedMessageIds = [String]()
+        journal.droppedEventsHandler = { droppedMessageIds += $0 }
+        
+        let events = (0..<10).map { event(index: $0) }
+        events.forEach { journal.append($0) }
+        let keptMessageIds = journal.prefix(10).map { $0.header.messageId }
+        
+        XCTAssertEqual(droppedMessageIds, events[0..<6].map { $0.header.messageId })
+        XCTAssertEqual(keptMessageIds, events[6...].map { $0.header.messageId })
+    }
+    
+    func testCompactionKeepsEventsAfterRemoval() throws {
+        let eventSize = try recordSize(of: event(index: 0))
+        let journal = try EventJournal(url: url, capacity: 16 + eventSize * 4 + eventSize / 2)
+        var droppedMessageIds = [String]()
+        journal.droppedEventsHandler = { droppedMessageIds += $0 }
+        
+        let events = (0..<6).map { event(index: $0) }
+        events[0..<4].forEach { journal.append($0) }
+        journal.removeFirst(messageIds: events[0..<2].map { $0.header.messageId })
+        
+        // The records are moved to the front without dropping.
+        events[4...].forEach { journal.append($0) }
+        
+        XCTAssertEqual(journal.prefix(10).map { $0.header.messageId }, events[2...].map { $0.header.messageId })
+        XCTAssertTrue(droppedMessageIds.isEmpty)
+    }
+    
+    func testEventsAreKeptAfterReopen() throws {
+        let events = (0..<3).map { event(index: $0) }
+        var journal: EventJournal? = try EventJournal(url: url, capacity: 64 * 1024)
+        events.forEach { journal?.append($0) }
+        journal?.removeFirst(messageIds: [events[0].header.messageId])
+        // Waits for the appends to be written.
+        _ = journal?.prefix(0)
+        journal = nil
+        
+        let reopenedJournal = try EventJournal(url: url, capacity: 64 * 1024)
+        XCTAssertEqual(reopenedJournal.prefix(10).map { $0.header.messageId }, events[1...].map { $0.header.messageId })
+    }
+    
+    func testBrokenJournalIsInitialized() throws {
+        try Data(repeating: 0xFF, count: 1024).write(to: url)
+        
+        let journal = try EventJournal(url: url, capacity: 64 * 1024)
+        XCTAssertTrue(journal.prefix(10).isEmpty)
+        
+        let event = self.event(index: 0)
+        journal.append(event)
+        XCTAssertEqual(journal.prefix(10).map { $0.header.messageId }, [event.header.messageId])
+    }
+}
+
+// MARK: - Private
+
+private extension EventJournalTests {
+    func event(index: Int) -> Upstream.Event {
+        return Upstream.Event(
+            payload: ["index": index, "playServiceId": "nugu.builtin.music", "token": "token-\(index)"],
+            header: Upstream.Header(
+                namespace: "AudioPlayer",
+                name: "PlaybackFinished",
+                version: "1.6",
+                dialogRequestId: "dialog-request-id-\(index)",
+                messageId: String(format: "message-id-%04d", index)
+            ),
+            contextPayload: [ContextInfo(contextType: .capability, name: "AudioPlayer", payload: ["version": "1.6"])]
+        )
+    }
+    
+    /// The length and the body of the event part.
+    func recordSize(of event: Upstream.Event) throws -> Int {
+        var jsonWriter = JSONStreamWriter()
+        event.writeBody(to: &jsonWriter)
+        return MemoryLayout<UInt32>.size + jsonWriter.data.count
+    }
+}
@@ -0,0 +1,124 @@
+//
+//  CompressedData.swift
+//  NuguCoreTests
+//
+//  Created by agent on 2026/10/17.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+import Compression
+
+/**
+ Compresses the part body as the device gateway does for `Content-Encoding`.
+ 
+ The wrappers are written by hand with the trailers. So the optional fields of gzip header can be put in.
+ */
+enum CompressedData {
+    /// Raw deflate data. (RFC 1951)
+    static func deflate(_ data: Data) -> Data {
+        let capacity = data.count + 1024
+        var compressedData = Data(count: capacity)
+        let compressedCount = compressedData.withUnsafeMutableBytes { (destination: UnsafeMutableRawBufferPointer) in
+            data.withUnsafeBytes { (source: UnsafeRawBufferPointer) in
+                compression_encode_buffer(
+                    destination.bindMemory(to: UInt8.self).baseAddress!, capacity,
+                    source.bindMemory(to: UInt8.self).baseAddress!, data.count,
+                    nil, COMPRESSION_ZLIB
+                )
+            }
+        }
+        
+        return compressedData.prefix(compressedCount)
+    }
+    
+    /// zlib wrapped deflate data. (RFC 1950)
+    static func zlib(_ data: Data) -> Data {
+        var compressedData = Data([0x78, 0x9c])
+        compressedData.append(deflate(data))
+        compressedData.append(bigEndianBytes(of: adler32(data)))
+        
+        return compressedData
+    }
+    
+    /// gzip data. (RFC 1952) The optional header fields are put in if they are given.
+    static func gzip(_ data: Data, extra: Data? = nil, name: String? = nil, comment: String? = nil, hasHeaderCRC: Bool = false) -> Data {
+        var flags: UInt8 = 0
+        var optionalFields = Data()
+        if let extra = extra {
+            flags |= 0x04
+            optionalFields.append(contentsOf: [UInt8(extra.count & 0xff), UInt8(extra.count >> 8)])
+            optionalFields.append(extra)
+        }
+        if let name = name {
+            flags |= 0x08
+            optionalFields.append(Data(name.utf8) + [0])
+        }
+        if let comment = comment {
+            flags |= 0x10
+            optionalFields.append(Data(comment.utf8) + [0])
+        }
+        if hasHeaderCRC {
+            flags |= 0x02
+        }
+        
+        // Modification time is 0 and OS is unix.
+        var compressedData = Data([0x1f, 0x8b, 8, flags, 0, 0, 0, 0, 0, 3])
+        compressedData.append(optionalFields)
+        if hasHeaderCRC {
+            compressedData.append(littleEndianBytes(of: crc32(compressedData)).prefix(2))
+        }
+        compressedData.append(deflate(data))
+        compressedData.append(littleEndianBytes(of: crc32(data)))
+        compressedData.append(littleEndianBytes(of: UInt32(truncatingIfNeeded: data.count)))
+        
+        return compressedData
+    }
+}
+
+// MARK: - Private
+
+private extension CompressedData {
+    static func crc32(_ data: Data) -> UInt32 {
+        var crc: UInt32 = 0xffffffff
+        for byte in data {
+            crc ^= UInt32(byte)
+            for _ in 0..<8 {
+                crc = crc & 1 == 1 ? (crc >> 1) ^ 0xedb88320 : crc >> 1
+            }
+        }
+        
+        return ~crc
+    }
+    
+    static func adler32(_ data: Data) -> UInt32 {
+        var a: UInt32 = 1
+        var b: UInt32 = 0
+        for byte in data {
+            a = (a + UInt32(byte)) % 65521
+            b = (b + a) % 65521
+        }
+        
+        return b << 16 | a
+    }
+    
+    static func littleEndianBytes(of value: UInt32) -> Data {
+        return Data((0..<4).map { UInt8(truncatingIfNeeded: value >> ($0 * 8)) })
+    }
+    
+    static func bigEndianBytes(of value: UInt32) -> Data {
+        return Data(littleEndianBytes(of: value).reversed())
+    }
+}
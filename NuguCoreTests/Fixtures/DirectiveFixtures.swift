@@ -0,0 +1,176 @@
+//
+//  DirectiveFixtures.swift
+//  NuguCoreTests
+//
+//  Created by agent on 2026/10/17.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/**
+ Directive bodies recorded from the device gateway.
+ 
+ Tokens, URLs and identifiers are replaced with dummy values. The structure and the size are kept as they were received.
+ */
+enum DirectiveFixtures {
+    /// `TTS.Speak` and `Display.ListTemplate1` of the weekly weather.
+    static let displayTemplate: Data = {
+        let items = (0..<7).map { index in
+            """
+                      {
+                        "token": "item-token-\(index)",
+                        "image": { "sources": [{ "url": "https://image.example.com/weather/icon_\(index).png", "size": "SMALL" }] },
+                        "header": { "text": "\(index + 18)일 \(["월", "화", "수", "목", "금", "토", "일"][index])요일", "color": "#222222" },
+                        "body": [
+                          { "text": "최고 \(24 + index)° / 최저 \(15 + index)°", "color": "#444444" },
+                          { "text": "강수확률 \(index * 10)%, 미세먼지 \\"보통\\"", "color": "#888888" }
+                        ],
+                        "footer": { "text": "{출처: 기상청}" }
+                      }
+            """
+        }
+        
+        return Data("""
+        {
+          "directives": [
+            {
+              "header": {
+                "namespace": "TTS",
+                "name": "Speak",
+                "dialogRequestId": "8a7a1d36-6f5d-4c89-b9f5-8f6ab7e3f2a1",
+                "messageId": "d2e4b6f0-0d5c-4e3b-9f3e-7c1a2b3c4d5e",
+                "version": "1.3",
+                "messageTimestamp": 1634108880123
+              },
+              "payload": {
+                "format": "SKML",
+                "text": "<speak>이번 주 서울 날씨예요. 월요일은 맑고, 주말에는 비 소식이 있어요.</speak>",
+                "token": "tts-token-0123456789abcdef",
+                "playServiceId": "nugu.builtin.weather"
+              }
+            },
+            {
+              "header": {
+                "namespace": "Display",
+                "name": "ListTemplate1",
+                "dialogRequestId": "8a7a1d36-6f5d-4c89-b9f5-8f6ab7e3f2a1",
+                "messageId": "0f1e2d3c-4b5a-6978-8796-a5b4c3d2e1f0",
+                "version": "1.9",
+                "messageTimestamp": 1634108880124
+              },
+              "payload": {
+                "playServiceId": "nugu.builtin.weather",
+                "token": "display-token-0123456789abcdef",
+                "duration": "MID",
+                "contextLayer": "INFO",
+                "title": {
+                  "logo": { "sources": [{ "url": "https://image.example.com/logo/weather.png" }] },
+                  "text": { "text": "주간 날씨" },
+                  "subtext": { "text": "서울특별시 중구" }
+                },
+                "background": { "color": "#ffffff" },
+                "listItems": [
+        \(items.joined(separator: ",\n"))
+                ],
+                "toggle": { "style": "text", "status": "off", "token": "toggle-token" },
+                "grammarGuide": ["내일 날씨 알려줘", "주말 날씨 알려줘"]
+              }
+            }
+          ]
+        }
+        """.utf8)
+    }()
+    
+    /// `AudioPlayer.Play` of a music with the playlist of `AudioPlayer.Template1`.
+    static let audioPlayerPlaylist: Data = {
+        let items = (0..<30).map { index in
+            """
+                          {
+                            "token": "track-token-\(index)",
+                            "text": { "text": "Track \(index + 1) - \\"Artist \(index % 5)\\"" },
+                            "subtext": { "text": "Album \(index / 10)" },
+                            "image": { "url": "https://image.example.com/album/\(index / 10).jpg" },
+                            "favorite": { "status": \(index % 3 == 0), "token": "favorite-token-\(index)" },
+                            "postback": { "type": "play", "data": { "index": \(index), "playlistId": "playlist-0" } }
+                          }
+            """
+        }
+        
+        return Data("""
+        {
+          "directives": [
+            {
+              "header": {
+                "namespace": "AudioPlayer",
+                "name": "Play",
+                "dialogRequestId": "3c4d5e6f-7a8b-4c9d-8e0f-1a2b3c4d5e6f",
+                "messageId": "6f5e4d3c-2b1a-4098-8f7e-6d5c4b3a2910",
+                "version": "1.6",
+                "messageTimestamp": 1634108950321
+              },
+              "payload": {
+                "playServiceId": "nugu.builtin.music",
+                "cacheKey": "cache-key-0",
+                "audioItem": {
+                  "stream": {
+                    "url": "https://stream.example.com/track/0.m3u8?token=stream-token",
+                    "offsetInMilliseconds": 0,
+                    "progressReport": { "progressReportDelayInMilliseconds": 0, "progressReportIntervalInMilliseconds": 60000 },
+                    "token": "track-token-0"
+                  },
+                  "metadata": {
+                    "template": {
+                      "type": "AudioPlayer.Template1",
+                      "title": { "iconUrl": "https://image.example.com/logo/music.png", "text": "Music" },
+                      "content": {
+                        "title": "Track 1",
+                        "subtitle1": "Artist 0",
+                        "subtitle2": "Album 0",
+                        "imageUrl": "https://image.example.com/album/0.jpg",
+                        "durationSec": "215",
+                        "backgroundColor": "#1d1d1d",
+                        "lyrics": {
+                          "title": "Track 1 - Artist 0",
+                          "lyricsType": "SYNC",
+                          "lyricsInfoList": [
+                            { "time": 12000, "text": "{첫 번째 소절}" },
+                            { "time": 18500, "text": "\\"두 번째\\" 소절" },
+                            { "time": 24000, "text": "세 번째 소절 [반복]" }
+                          ]
+                        },
+                        "settings": { "favorite": true, "repeat": "NONE", "shuffle": false }
+                      },
+                      "playlist": {
+                        "title": { "text": "오늘의 추천" },
+                        "edit": { "text": "편집" },
+                        "list": {
+                          "items": [
+        \(items.joined(separator: ",\n"))
+                          ]
+                        },
+                        "currentToken": "track-token-0"
+                      }
+                    }
+                  }
+                },
+                "sourceType": "URL"
+              }
+            }
+          ]
+        }
+        """.utf8)
+    }()
+}
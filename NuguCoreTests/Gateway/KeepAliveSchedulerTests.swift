@@ -0,0 +1,164 @@
+//
+//  KeepAliveSchedulerTests.swift
+//  NuguCoreTests
+//
+//  Created by agent on 2026/10/17.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+
+import NuguUtils
+import RxSwift
+@testable import NuguCore
+
+/// The idle time is advanced by the clock injected. The ping is served by `StandInGateway`.
+final class KeepAliveSchedulerTests: XCTestCase {
+    private let authorization = StandInGateway.Authorization()
+    private var disposeBag = DisposeBag()
+    private var apiProvider: NuguApiProvider!
+    
+    override func setUp() {
+        super.setUp()
+        StandInGateway.reset()
+        AuthorizationStore.shared.delegate = authorization
+        NuguServerInfo.l4SwitchAddress = StandInGateway.resourceServerAddress
+        apiProvider = NuguApiProvider(sessionConfiguration: StandInGateway.sessionConfiguration())
+    }
+    
+    override func tearDown() {
+        disposeBag = DisposeBag()
+        apiProvider = nil
+        StandInGateway.reset()
+        AuthorizationStore.shared.delegate = nil
+        super.tearDown()
+    }
+    
+    func testDisconnectWhileUsedIsIgnored() {
+        let keepAliveScheduler = KeepAliveScheduler(apiProvider: apiProvider)
+        let estimatedIdleTimeout = keepAliveScheduler.estimatedIdleTimeout
+        
+        keepAliveScheduler.connectionDidDisconnect()
+        
+        XCTAssertEqual(keepAliveScheduler.estimatedIdleTimeout, estimatedIdleTimeout)
+    }
+    
+    func testIdleTimeoutIsLearnedFromIdleDisconnect() throws {
+        #if os(iOS)
+        try XCTSkipUnless(NetworkReachabilityManager.shared.isReachable, "The disconnect is not learned while the network is not reachable.")
+        #endif
+        
+        let idleDate = apiProvider.lastActivityDate.addingTimeInterval(100)
+        let keepAliveScheduler = KeepAliveScheduler(apiProvider: apiProvider) { idleDate }
+        let estimatedIdleTimeout = keepAliveScheduler.estimatedIdleTimeout
+        
+        keepAliveScheduler.connectionDidDisconnect()
+        
+        XCTAssertEqual(keepAliveScheduler.estimatedIdleTimeout, (estimatedIdleTimeout + 100) / 2, accuracy: 0.001)
+    }
+    
+    func testPingIsSentBeforeIdleTimeout() {
+        let pinged = expectation(description: "pinged")
+        pinged.assertForOverFulfill = false
+        StandInGateway.handler = { request in
+            if request.url?.path == "/v2/ping" {
+                pinged.fulfill()
+            }
+            return StandInGateway.Response()
+        }
+        
+        // Idle for the most of the default idle timeout.
+        let idleDate = apiProvider.lastActivityDate.addingTimeInterval(250)
+        let keepAliveScheduler = KeepAliveScheduler(apiProvider: apiProvider) { idleDate }
+        keepAliveScheduler.reconnectRequired
+            .subscribe(onNext: {
+                XCTFail("reconnect is not required")
+            })
+            .disposed(by: disposeBag)
+        
+        keepAliveScheduler.start()
+        wait(for: [pinged], timeout: 5)
+        keepAliveScheduler.stop()
+    }
+    
+    func testReconnectIsRequiredWhenPingFails() {
+        StandInGateway.handler = { _ in StandInGateway.Response(statusCode: 500) }
+        
+        let idleDate = apiProvider.lastActivityDate.addingTimeInterval(250)
+        let keepAliveScheduler = KeepAliveScheduler(apiProvider: apiProvider, pingRetryInterval: 0.1) { idleDate }
+        let reconnectRequired = expectation(description: "reconnect required")
+        keepAliveScheduler.reconnectRequired
+            .take(1)
+            .subscribe(onNext: {
+                reconnectRequired.fulfill()
+            })
+            .disposed(by: disposeBag)
+        
+        keepAliveScheduler.start()
+        wait(for: [reconnectRequired], timeout: 5)
+        keepAliveScheduler.stop()
+        
+        // The first ping and 3 retries.
+        XCTAssertEqual(StandInGateway.servedRequests(path: "/v2/ping").count, 4)
+    }
+    
+    func testReconnectIsNotRequiredWhenRetriedPingSucceeds() {
+        let pinged = expectation(description: "pinged")
+        pinged.assertForOverFulfill = false
+        StandInGateway.handler = { request in
+            guard request.url?.path == "/v2/ping" else { return StandInGateway.Response() }
+            
+            // Fails twice and succeeds.
+            guard StandInGateway.servedRequests(path: "/v2/ping").count <= 2 else {
+                pinged.fulfill()
+                return StandInGateway.Response()
+            }
+            return StandInGateway.Response(statusCode: 500)
+        }
+        
+        let idleDate = apiProvider.lastActivityDate.addingTimeInterval(250)
+        let keepAliveScheduler = KeepAliveScheduler(apiProvider: apiProvider, pingRetryInterval: 0.1) { idleDate }
+        keepAliveScheduler.reconnectRequired
+            .subscribe(onNext: {
+                XCTFail("reconnect is not required")
+            })
+            .disposed(by: disposeBag)
+        
+        keepAliveScheduler.start()
+        wait(for: [pinged], timeout: 5)
+        keepAliveScheduler.stop()
+        XCTAssertEqual(StandInGateway.servedRequests(path: "/v2/ping").count, 3)
+    }
+    
+    func testReconnectIsRequiredWithoutPingWhenIdleCutoffHasPassed() {
+        StandInGateway.handler = { _ in StandInGateway.Response() }
+        
+        // ex. The timer was suspended in background.
+        let idleDate = apiProvider.lastActivityDate.addingTimeInterval(400)
+        let keepAliveScheduler = KeepAliveScheduler(apiProvider: apiProvider) { idleDate }
+        let reconnectRequired = expectation(description: "reconnect required")
+        keepAliveScheduler.reconnectRequired
+            .take(1)
+            .subscribe(onNext: {
+                reconnectRequired.fulfill()
+            })
+            .disposed(by: disposeBag)
+        
+        keepAliveScheduler.start()
+        wait(for: [reconnectRequired], timeout: 5)
+        keepAliveScheduler.stop()
+        XCTAssertTrue(StandInGateway.servedRequests(path: "/v2/ping").isEmpty)
+    }
+}
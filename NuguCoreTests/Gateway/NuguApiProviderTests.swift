@@ -0,0 +1,368 @@
+//
+//  NuguApiProviderTests.swift
+//  NuguCoreTests
+//
+//  Created by agent on 2026/10/17.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+
+import RxSwift
+@testable import NuguCore
+
+/// Drives `NuguApiProvider` against `StandInGateway` through the session configuration.
+final class NuguApiProviderTests: XCTestCase {
+    private let authorization = StandInGateway.Authorization()
+    private var disposeBag = DisposeBag()
+    
+    override func setUp() {
+        super.setUp()
+        StandInGateway.reset()
+        AuthorizationStore.shared.delegate = authorization
+        NuguServerInfo.registryServerAddress = StandInGateway.registryServerAddress
+        NuguServerInfo.l4SwitchAddress = StandInGateway.resourceServerAddress
+    }
+    
+    override func tearDown() {
+        disposeBag = DisposeBag()
+        StandInGateway.reset()
+        AuthorizationStore.shared.delegate = nil
+        super.tearDown()
+    }
+    
+    func testPingIsCountedAsActivity() {
+        StandInGateway.handler = { _ in StandInGateway.Response() }
+        let provider = NuguApiProvider(sessionConfiguration: StandInGateway.sessionConfiguration())
+        let lastActivityDate = provider.lastActivityDate
+        let pinged = expectation(description: "pinged")
+        
+        provider.ping
+            .subscribe(onCompleted: {
+                pinged.fulfill()
+            }, onError: { error in
+                XCTFail("ping failed: \(error)")
+            })
+            .disposed(by: disposeBag)
+        wait(for: [pinged], timeout: 5)
+        
+        XCTAssertLessThan(lastActivityDate, provider.lastActivityDate)
+        let pingRequest = StandInGateway.servedRequests(path: "/v2/ping").first
+        XCTAssertEqual(pingRequest?.value(forHTTPHeaderField: "Authorization"), "Bearer stand-in-token")
+    }
+    
+    func testDirectivesAreReceivedFromGateway() {
+        let boundary = "stand-in-boundary"
+        let directiveBody = Data(#"{"directives":[{"header":{"namespace":"TTS","name":"Speak","dialogRequestId":"d","messageId":"m","version":"1.3"},"payload":{}}]}"#.utf8)
+        let attachmentBody = Data(repeating: 0x4F, count: 1024)
+        var message = Data("--\(boundary)\r\nContent-Type: application/json\r\nContent-Length: \(directiveBody.count)\r\n\r\n".utf8)
+        message.append(directiveBody)
+        message.append(Data("\r\n--\(boundary)\r\nContent-Type: audio/opus\r\nFilename: 0;end\r\nContent-Length: \(attachmentBody.count)\r\n\r\n".utf8))
+        message.append(attachmentBody)
+        message.append(Data("\r\n".utf8))
+        
+        StandInGateway.handler = { request in
+            switch request.url?.path {
+            case "/v1/policies":
+                return StandInGateway.Response(chunks: [NuguApiProviderTests.policyData(hostnames: ["resource.gateway.test"])])
+            case "/v2/ping":
+                return StandInGateway.Response()
+            case "/v2/directives":
+                // Chunks are split in the middle of boundaries and headers.
+                let chunks = stride(from: 0, to: message.count, by: 37).map { message[$0..<min($0 + 37, message.count)] }
+                return StandInGateway.Response(
+                    headerFields: ["Content-Type": "multipart/related; boundary=\(boundary)"],
+                    chunks: chunks,
+                    isEndless: true
+                )
+            default:
+                return nil
+            }
+        }
+        
+        let provider = NuguApiProvider(sessionConfiguration: StandInGateway.sessionConfiguration())
+        let received = expectation(description: "received")
+        var parts = [MultiPartParser.Part]()
+        
+        provider.directive
+            .take(2)
+            .subscribe(onNext: { part in
+                parts.append(part)
+            }, onError: { error in
+                XCTFail("directive failed: \(error)")
+            }, onCompleted: {
+                received.fulfill()
+            })
+            .disposed(by: disposeBag)
+        wait(for: [received], timeout: 5)
+        
+        XCTAssertEqual(provider.loadBalancedUrl, "https://resource.gateway.test:443")
+        XCTAssertEqual(parts.map { $0.body.data }, [directiveBody, attachmentBody])
+    }
+    
+    func testCompressedDirectivesAreInflatedFromGateway() {
+        let directiveBody = NuguApiProviderTests.directiveData(dialogRequestId: "compressed")
+        let attachmentBody = Data((0..<4096).map { UInt8($0 % 7) })
+        StandInGateway.handler = { request in
+            switch request.url?.path {
+            case "/v1/policies":
+                return StandInGateway.Response(chunks: [NuguApiProviderTests.policyData(hostnames: ["resource.gateway.test"])])
+            case "/v2/ping":
+                return StandInGateway.Response()
+            case "/v2/directives":
+                // The part which cannot be inflated is dropped and the next one is received.
+                return StandInGateway.multiPartResponse(
+                    [
+                        (["Content-Type": "application/json", "Content-Encoding": "gzip"], CompressedData.gzip(directiveBody, name: "directive.json")),
+                        (["Content-Type": "application/json", "Content-Encoding": "deflate"], Data(repeating: 0xff, count: 64)),
+                        (["Content-Type": "audio/opus", "Filename": "0;continued", "Content-Encoding": "deflate"], CompressedData.zlib(attachmentBody)),
+                        (["Content-Type": "audio/opus", "Filename": "1;end", "Content-Encoding": "deflate"], CompressedData.deflate(attachmentBody))
+                    ],
+                    chunkSizes: [1, 9, 3, 77, 2, 23],
+                    isEndless: true
+                )
+            default:
+                return nil
+            }
+        }
+        
+        let provider = NuguApiProvider(sessionConfiguration: StandInGateway.sessionConfiguration())
+        let received = expectation(description: "received")
+        var parts = [MultiPartParser.Part]()
+        
+        provider.directive
+            .take(3)
+            .subscribe(onNext: { part in
+                parts.append(part)
+            }, onError: { error in
+                XCTFail("directive failed: \(error)")
+            }, onCompleted: {
+                received.fulfill()
+            })
+            .disposed(by: disposeBag)
+        wait(for: [received], timeout: 5)
+        
+        XCTAssertEqual(parts.map { $0.body.data }, [directiveBody, attachmentBody, attachmentBody])
+        XCTAssertEqual(parts.map { $0.header[.filename] }, [nil, "0;continued", "1;end"])
+    }
+    
+    func testLatencyProbingConnectsToFirstRespondingServer() {
+        let slowServerLatency: TimeInterval = 2
+        StandInGateway.handler = { request in
+            switch (request.url?.host, request.url?.path) {
+            case (_, "/v1/policies"):
+                return StandInGateway.Response(chunks: [NuguApiProviderTests.policyData(hostnames: ["slow.gateway.test", "fast.gateway.test"])])
+            case ("slow.gateway.test", "/v2/ping"):
+                return StandInGateway.Response(delay: slowServerLatency)
+            case ("fast.gateway.test", "/v2/ping"):
+                return StandInGateway.Response()
+            default:
+                return nil
+            }
+        }
+        
+        let provider = NuguApiProvider(sessionConfiguration: StandInGateway.sessionConfiguration())
+        provider.isLatencyProbingEnabled = true
+        let resolved = expectation(description: "resolved")
+        let startTime = Date()
+        var timeToResolve: TimeInterval?
+        
+        provider.policies
+            .subscribe(onSuccess: { _ in
+                timeToResolve = Date().timeIntervalSince(startTime)
+                resolved.fulfill()
+            }, onFailure: { error in
+                XCTFail("policies failed: \(error)")
+            })
+            .disposed(by: disposeBag)
+        wait(for: [resolved], timeout: 5)
+        
+        // The connection doesn't wait for the slow server.
+        XCTAssertEqual(provider.loadBalancedUrl, "https://fast.gateway.test:443")
+        XCTAssertLessThan(timeToResolve ?? .infinity, slowServerLatency)
+    }
+    
+    func testEventIsAnsweredThroughEventsEndpoint() {
+        StandInGateway.handler = { request in
+            guard request.url?.path == "/v2/events",
+                  let eventPart = StandInGateway.parts(of: request).first,
+                  let eventBody = try? JSONSerialization.jsonObject(with: eventPart.body.data) as? [String: Any],
+                  let header = (eventBody["event"] as? [String: Any])?["header"] as? [String: Any],
+                  let dialogRequestId = header["dialogRequestId"] as? String else {
+                return StandInGateway.Response(statusCode: 400)
+            }
+            
+            // The directive is split across chunks.
+            return StandInGateway.multiPartResponse(
+                [(["Content-Type": "application/json"], NuguApiProviderTests.directiveData(dialogRequestId: dialogRequestId))],
+                chunkSize: 29
+            )
+        }
+        
+        let provider = NuguApiProvider(sessionConfiguration: StandInGateway.sessionConfiguration())
+        let boundary = HTTPConst.boundaryPrefix + UUID().uuidString
+        let eventSender = EventSender(boundary: boundary)
+        let completed = expectation(description: "completed")
+        var parts = [MultiPartParser.Part]()
+        
+        provider.events(boundary: boundary, httpHeaderFields: nil, inputStream: eventSender.inputStream)
+            .subscribe(onNext: { part in
+                parts.append(part)
+            }, onError: { error in
+                XCTFail("events failed: \(error)")
+            }, onCompleted: {
+                completed.fulfill()
+            })
+            .disposed(by: disposeBag)
+        eventSender.send(NuguApiProviderTests.event(dialogRequestId: "event-dialog-request-id"))
+        eventSender.finish()
+        wait(for: [completed], timeout: 5)
+        
+        XCTAssertEqual(parts.count, 1)
+        XCTAssertEqual(try DirectiveDecoder.decode(parts[0].body).first?.header.dialogRequestId, "event-dialog-request-id")
+        XCTAssertEqual(StandInGateway.servedRequests(path: "/v2/events").first.map { StandInGateway.parts(of: $0).count }, 1)
+    }
+    
+    func testCompressedEventResponseIsInflated() {
+        StandInGateway.handler = { request in
+            guard request.url?.path == "/v2/events" else {
+                return StandInGateway.Response(statusCode: 400)
+            }
+            
+            let directiveData = NuguApiProviderTests.directiveData(dialogRequestId: "event-dialog-request-id")
+            return StandInGateway.multiPartResponse(
+                [
+                    (["Content-Type": "application/json", "Content-Encoding": "br"], directiveData),
+                    (["Content-Type": "application/json", "Content-Encoding": "gzip"], CompressedData.gzip(directiveData, extra: Data([1, 2, 3]), hasHeaderCRC: true)),
+                    (["Content-Type": "application/json", "Content-Encoding": "deflate"], CompressedData.zlib(directiveData))
+                ],
+                chunkSizes: [3, 1, 50, 6]
+            )
+        }
+        
+        let provider = NuguApiProvider(sessionConfiguration: StandInGateway.sessionConfiguration())
+        let boundary = HTTPConst.boundaryPrefix + UUID().uuidString
+        let eventSender = EventSender(boundary: boundary)
+        let completed = expectation(description: "completed")
+        var parts = [MultiPartParser.Part]()
+        
+        provider.events(boundary: boundary, httpHeaderFields: nil, inputStream: eventSender.inputStream)
+            .subscribe(onNext: { part in
+                parts.append(part)
+            }, onError: { error in
+                XCTFail("events failed: \(error)")
+            }, onCompleted: {
+                completed.fulfill()
+            })
+            .disposed(by: disposeBag)
+        eventSender.send(NuguApiProviderTests.event(dialogRequestId: "event-dialog-request-id"))
+        eventSender.finish()
+        wait(for: [completed], timeout: 5)
+        
+        // The part of unsupported encoding is dropped.
+        XCTAssertEqual(parts.count, 2)
+        XCTAssertEqual(try parts.map { try DirectiveDecoder.decode($0.body).first?.header.dialogRequestId }, ["event-dialog-request-id", "event-dialog-request-id"])
+    }
+    
+    func testErrorStatusIsDeliveredAfterEventIsRead() {
+        StandInGateway.handler = { _ in StandInGateway.Response(statusCode: 500) }
+        
+        let provider = NuguApiProvider(sessionConfiguration: StandInGateway.sessionConfiguration())
+        let boundary = HTTPConst.boundaryPrefix + UUID().uuidString
+        let eventSender = EventSender(boundary: boundary)
+        let failed = expectation(description: "failed")
+        
+        provider.events(boundary: boundary, httpHeaderFields: nil, inputStream: eventSender.inputStream)
+            .subscribe(onError: { error in
+                XCTAssertEqual(error as? NetworkError, .unknown)
+                failed.fulfill()
+            }, onCompleted: {
+                XCTFail("events must fail")
+            })
+            .disposed(by: disposeBag)
+        eventSender.send(NuguApiProviderTests.event(dialogRequestId: "event-dialog-request-id"))
+        eventSender.finish()
+        wait(for: [failed], timeout: 5)
+        
+        // The gateway has read the whole event before it responded.
+        let eventRequest = StandInGateway.servedRequests(path: "/v2/events").first
+        XCTAssertEqual(eventRequest.map { StandInGateway.parts(of: $0).count }, 1)
+    }
+    
+    func testDirectiveStreamFailsInTheMiddle() {
+        StandInGateway.handler = { request in
+            switch request.url?.path {
+            case "/v1/policies":
+                return StandInGateway.Response(chunks: [NuguApiProviderTests.policyData(hostnames: ["resource.gateway.test"])])
+            case "/v2/ping":
+                return StandInGateway.Response()
+            case "/v2/directives":
+                var response = StandInGateway.multiPartResponse(
+                    [(["Content-Type": "application/json"], NuguApiProviderTests.directiveData(dialogRequestId: "first"))],
+                    chunkSize: 41,
+                    isEndless: true
+                )
+                // The second part is cut off.
+                response.chunks.append(Data("--\(StandInGateway.boundary)\r\nContent-Type: application/json\r\nContent-Le".utf8))
+                response.failure = .networkConnectionLost
+                return response
+            default:
+                return nil
+            }
+        }
+        
+        let provider = NuguApiProvider(sessionConfiguration: StandInGateway.sessionConfiguration())
+        let failed = expectation(description: "failed")
+        var parts = [MultiPartParser.Part]()
+        
+        provider.directive
+            .subscribe(onNext: { part in
+                parts.append(part)
+            }, onError: { error in
+                XCTAssertEqual((error as? URLError)?.code, .networkConnectionLost)
+                failed.fulfill()
+            })
+            .disposed(by: disposeBag)
+        wait(for: [failed], timeout: 5)
+        
+        XCTAssertEqual(parts.count, 1)
+        XCTAssertEqual(try parts.first.flatMap { try DirectiveDecoder.decode($0.body).first?.header.dialogRequestId }, "first")
+    }
+}
+
+// MARK: - Private
+
+private extension NuguApiProviderTests {
+    static func event(dialogRequestId: String) -> Upstream.Event {
+        return Upstream.Event(
+            payload: ["text": "stand-in"],
+            header: Upstream.Header(namespace: "Text", name: "TextInput", version: "1.0", dialogRequestId: dialogRequestId, messageId: UUID().uuidString),
+            contextPayload: []
+        )
+    }
+    
+    static func directiveData(dialogRequestId: String) -> Data {
+        return Data(#"{"directives":[{"header":{"namespace":"TTS","name":"Speak","dialogRequestId":"\#(dialogRequestId)","messageId":"\#(UUID().uuidString)","version":"1.3"},"payload":{}}]}"#.utf8)
+    }
+    
+    static func policyData(hostnames: [String]) -> Data {
+        let serverPolicies = hostnames.map {
+            #"{"protocol":"H2","hostname":"\#($0)","port":443,"retryCountLimit":2,"connectionTimeout":10000,"charge":"NORMAL"}"#
+        }
+        let healthCheckPolicy = #"{"ttl":10000,"ttlMax":20000,"beta":1,"retryCountLimit":3,"retryDelay":1000,"healthCheckTimeout":3000,"accumulationTime":60000}"#
+        
+        return Data(#"{"serverPolicies":[\#(serverPolicies.joined(separator: ","))],"healthCheckPolicy":\#(healthCheckPolicy)}"#.utf8)
+    }
+}
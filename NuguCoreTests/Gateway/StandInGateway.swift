@@ -0,0 +1,244 @@
+//
+//  StandInGateway.swift
+//  NuguCoreTests
+//
+//  Created by agent on 2026/10/17.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+import NuguUtils
+@testable import NuguCore
+
+/**
+ Serves the requests of `NuguApiProvider` instead of the registry and device gateway.
+ 
+ It is registered by `URLSessionConfiguration.protocolClasses` which is injected to the provider.
+ The response of each request is made by `handler`, and every request served is recorded.
+ The body stream of the request (ex. `/v2/events`) is read until the sender finishes it, and the handler receives it as `httpBody`.
+ */
+final class StandInGateway: URLProtocol {
+    struct Response {
+        var statusCode = 200
+        var headerFields = [String: String]()
+        /// Body is delivered chunk by chunk in order.
+        var chunks = [Data]()
+        /// Time taken to respond. (ex. the latency of server)
+        var delay: TimeInterval = 0
+        /// The stream is not finished like server initiated directive.
+        var isEndless = false
+        /// The stream fails after the chunks are delivered. (ex. `.networkConnectionLost` in the middle of the directive stream)
+        var failure: URLError.Code?
+    }
+    
+    static let registryServerAddress = "https://registry.gateway.test"
+    static let resourceServerAddress = "https://resource.gateway.test"
+    static let boundary = "stand-in-boundary"
+    
+    /// `nil` response fails the request like unreachable host.
+    @Atomic static var handler: ((URLRequest) -> Response?)?
+    @Atomic static private(set) var servedRequests = [URLRequest]()
+    
+    private let responseQueue = DispatchQueue(label: "com.sktelecom.romaine.core_tests.stand_in_gateway")
+    @Atomic private var isStopped = false
+    
+    static func sessionConfiguration() -> URLSessionConfiguration {
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.protocolClasses = [StandInGateway.self]
+        return configuration
+    }
+    
+    static func reset() {
+        handler = nil
+        servedRequests = []
+    }
+    
+    static func servedRequests(path: String) -> [URLRequest] {
+        return servedRequests.filter { $0.url?.path == path }
+    }
+    
+    override class func canInit(with request: URLRequest) -> Bool {
+        return true
+    }
+    
+    override class func canonicalRequest(for request: URLRequest) -> URLRequest {
+        return request
+    }
+    
+    override func startLoading() {
+        responseQueue.async { [weak self] in
+            guard let self = self else { return }
+            
+            var request = self.request
+            if let bodyStream = request.httpBodyStream {
+                request.httpBody = self.readBody(bodyStream)
+            }
+            StandInGateway._servedRequests.mutate {
+                $0.append(request)
+            }
+            
+            guard self.isStopped == false else { return }
+            guard let url = request.url, let response = StandInGateway.handler?(request),
+                  let httpResponse = HTTPURLResponse(url: url, statusCode: response.statusCode, httpVersion: "HTTP/2", headerFields: response.headerFields) else {
+                self.client?.urlProtocol(self, didFailWithError: URLError(.cannotConnectToHost))
+                return
+            }
+            
+            self.responseQueue.asyncAfter(deadline: .now() + response.delay) { [weak self] in
+                self?.respond(response, with: httpResponse)
+            }
+        }
+    }
+    
+    override func stopLoading() {
+        isStopped = true
+    }
+}
+
+// MARK: - Multipart
+
+extension StandInGateway {
+    /// Parts of the multipart body which the request has sent. (ex. the event and attachments sent to `/v2/events`)
+    static func parts(of request: URLRequest) -> [MultiPartParser.Part] {
+        guard let contentType = request.value(forHTTPHeaderField: "Content-Type"),
+              let boundary = contentType.components(separatedBy: "boundary=").last,
+              let body = request.httpBody else {
+            return []
+        }
+        
+        return MultiPartParser(boundary: boundary).parse(data: body).compactMap { try? $0.get() }
+    }
+    
+    /**
+     Makes the multipart response of the parts like the device gateway does.
+     
+     - Parameter chunkSize: The message is split by it regardless of the boundaries and headers.
+     */
+    static func multiPartResponse(
+        _ parts: [(headerFields: [String: String], body: Data)],
+        chunkSize: Int = .max,
+        isEndless: Bool = false
+    ) -> Response {
+        return multiPartResponse(parts, chunkSizes: [chunkSize], isEndless: isEndless)
+    }
+    
+    /**
+     Makes the multipart response of the parts which is split unevenly.
+     
+     - Parameter chunkSizes: The message is split by the sizes in turn. (ex. [1, 7, 3] makes the chunks of 1, 7, 3, 1, 7, ... bytes)
+     */
+    static func multiPartResponse(
+        _ parts: [(headerFields: [String: String], body: Data)],
+        chunkSizes: [Int],
+        isEndless: Bool = false
+    ) -> Response {
+        var message = Data()
+        parts.forEach { part in
+            let headerFields = part.headerFields.merging(["Content-Length": "\(part.body.count)"]) { field, _ in field }
+            message.append(Data("--\(boundary)\r\n".utf8))
+            headerFields.forEach { message.append(Data("\($0.key): \($0.value)\r\n".utf8)) }
+            message.append(Data("\r\n".utf8))
+            message.append(part.body)
+            message.append(Data("\r\n".utf8))
+        }
+        if isEndless == false {
+            message.append(Data("--\(boundary)--\r\n".utf8))
+        }
+        
+        return Response(
+            headerFields: ["Content-Type": "multipart/related; boundary=\(boundary)"],
+            chunks: split(message, by: chunkSizes),
+            isEndless: isEndless
+        )
+    }
+    
+    static func split(_ data: Data, by chunkSizes: [Int]) -> [Data] {
+        var chunks = [Data]()
+        var index = 0
+        while index < data.count {
+            let chunkSize = min(chunkSizes[chunks.count % chunkSizes.count], data.count - index)
+            chunks.append(data[index..<(index + chunkSize)])
+            index += chunkSize
+        }
+        
+        return chunks
+    }
+}
+
+// MARK: - Authorization
+
+extension StandInGateway {
+    final class Authorization: AuthorizationStoreDelegate {
+        func authorizationStoreRequestAccessToken() -> String? {
+            return "stand-in-token"
+        }
+    }
+}
+
+// MARK: - Private
+
+private extension StandInGateway {
+    enum Const {
+        static let bodyReadSize = 16 * 1024
+        static let bodyPollInterval: TimeInterval = 0.001
+    }
+    
+    /// Reads the body stream until the sender finishes it or the request is stopped.
+    func readBody(_ bodyStream: InputStream) -> Data {
+        var body = Data()
+        var buffer = [UInt8](repeating: 0, count: Const.bodyReadSize)
+        bodyStream.open()
+        defer {
+            bodyStream.close()
+        }
+        
+        while isStopped == false {
+            switch bodyStream.streamStatus {
+            case .atEnd, .closed, .error:
+                return body
+            default:
+                break
+            }
+            
+            guard bodyStream.hasBytesAvailable else {
+                Thread.sleep(forTimeInterval: Const.bodyPollInterval)
+                continue
+            }
+            
+            let readLength = bodyStream.read(&buffer, maxLength: buffer.count)
+            guard 0 <= readLength else { return body }
+            
+            body.append(buffer, count: readLength)
+        }
+        
+        return body
+    }
+    
+    func respond(_ response: Response, with httpResponse: HTTPURLResponse) {
+        guard isStopped == false else { return }
+        
+        client?.urlProtocol(self, didReceive: httpResponse, cacheStoragePolicy: .notAllowed)
+        response.chunks.forEach {
+            client?.urlProtocol(self, didLoad: $0)
+        }
+        
+        if let failure = response.failure {
+            client?.urlProtocol(self, didFailWithError: URLError(failure))
+        } else if response.isEndless == false {
+            client?.urlProtocolDidFinishLoading(self)
+        }
+    }
+}
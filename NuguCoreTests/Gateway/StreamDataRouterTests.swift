@@ -0,0 +1,114 @@
+//
+//  StreamDataRouterTests.swift
+//  NuguCoreTests
+//
+//  Created by agent on 2026/10/17.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+
+import NuguUtils
+@testable import NuguCore
+
+/// Routes the events and directives through `StandInGateway` and the real `DirectiveSequencer`.
+final class StreamDataRouterTests: XCTestCase {
+    private let authorization = StandInGateway.Authorization()
+    private let directiveSequencer = DirectiveSequencer()
+    @Atomic private var directiveHandled: XCTestExpectation?
+    
+    override func setUp() {
+        super.setUp()
+        StandInGateway.reset()
+        AuthorizationStore.shared.delegate = authorization
+        NuguServerInfo.l4SwitchAddress = StandInGateway.resourceServerAddress
+        
+        // The event is answered by the directive of the same dialog request.
+        StandInGateway.handler = { request in
+            guard request.url?.path == "/v2/events",
+                  let eventPart = StandInGateway.parts(of: request).first,
+                  let eventBody = try? JSONSerialization.jsonObject(with: eventPart.body.data) as? [String: Any],
+                  let header = (eventBody["event"] as? [String: Any])?["header"] as? [String: Any],
+                  let dialogRequestId = header["dialogRequestId"] as? String else {
+                return StandInGateway.Response(statusCode: 400)
+            }
+            
+            let directive = #"{"directives":[{"header":{"namespace":"TTS","name":"Speak","dialogRequestId":"\#(dialogRequestId)","messageId":"\#(UUID().uuidString)","version":"1.3"},"payload":{"text":"stand-in"}}]}"#
+            return StandInGateway.multiPartResponse([(["Content-Type": "application/json"], Data(directive.utf8))])
+        }
+        
+        directiveSequencer.add(directiveHandleInfos: [
+            DirectiveHandleInfo(
+                namespace: "TTS",
+                name: "Speak",
+                blockingPolicy: BlockingPolicy(medium: .none, isBlocking: false),
+                directiveHandler: { { [weak self] _, completion in
+                    completion(.finished)
+                    self?.directiveHandled?.fulfill()
+                } }
+            )
+        ].asDictionary)
+    }
+    
+    override func tearDown() {
+        StandInGateway.reset()
+        AuthorizationStore.shared.delegate = nil
+        super.tearDown()
+    }
+    
+    func testEventIsAnsweredByHandledDirective() {
+        let router = StreamDataRouter(directiveSequencer: directiveSequencer, sessionConfiguration: StandInGateway.sessionConfiguration())
+        let received = expectation(description: "received")
+        directiveHandled = expectation(description: "handled")
+        
+        router.sendEvent(event()) { state in
+            if case .received(let directive) = state {
+                XCTAssertEqual(directive.header.type, "TTS.Speak")
+                received.fulfill()
+            }
+        }
+        wait(for: [received, directiveHandled!], timeout: 5)
+    }
+    
+    /// Measures the latency from sending an event to handling the directive which answers it.
+    func testEventToDirectiveHandledLatency() {
+        let router = StreamDataRouter(directiveSequencer: directiveSequencer, sessionConfiguration: StandInGateway.sessionConfiguration())
+        
+        measure {
+            for _ in 0..<Const.roundTripCount {
+                let handled = expectation(description: "handled")
+                directiveHandled = handled
+                router.sendEvent(event())
+                wait(for: [handled], timeout: 5)
+            }
+        }
+    }
+}
+
+// MARK: - Private
+
+private extension StreamDataRouterTests {
+    enum Const {
+        static let roundTripCount = 20
+    }
+    
+    func event() -> Upstream.Event {
+        return Upstream.Event(
+            payload: ["text": "stand-in"],
+            header: Upstream.Header(namespace: "Text", name: "TextInput", version: "1.0", dialogRequestId: UUID().uuidString, messageId: UUID().uuidString),
+            contextPayload: []
+        )
+    }
+}
@@ -0,0 +1,131 @@
+//
+//  JSONStreamWriterTests.swift
+//  NuguCoreTests
+//
+//  Created by agent on 2026/10/17.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+
+@testable import NuguCore
+
+final class JSONStreamWriterTests: XCTestCase {
+    func testWrittenDocumentIsDecodable() throws {
+        var writer = JSONStreamWriter()
+        writer.beginObject()
+        writer.writeMember("namespace", "ASR")
+        try writer.writeMember("payload", value: [
+            "integer": 10,
+            "double": 0.5,
+            "bool": true,
+            "null": NSNull(),
+            "array": ["a", 1, false],
+            "nested": ["key": "value"]
+        ] as [String: Any])
+        writer.writeKey("header")
+        writer.beginObject()
+        writer.writeMember("name", "Recognize")
+        writer.endObject()
+        writer.endObject()
+        
+        let object = try JSONSerialization.jsonObject(with: writer.data) as? NSDictionary
+        XCTAssertEqual(object, [
+            "namespace": "ASR",
+            "payload": [
+                "integer": 10,
+                "double": 0.5,
+                "bool": true,
+                "null": NSNull(),
+                "array": ["a", 1, false],
+                "nested": ["key": "value"]
+            ],
+            "header": ["name": "Recognize"]
+        ] as NSDictionary)
+    }
+    
+    func testBoolIsNotWrittenAsNumber() throws {
+        var writer = JSONStreamWriter()
+        writer.beginObject()
+        try writer.writeMember("bool", value: true)
+        try writer.writeMember("number", value: 1)
+        writer.endObject()
+        
+        XCTAssertEqual(String(decoding: writer.data, as: UTF8.self), #"{"bool":true,"number":1}"#)
+    }
+    
+    func testStringIsEscaped() throws {
+        let string = "quote\" backslash\\ newline\n tab\t control\u{01} 한글"
+        
+        var writer = JSONStreamWriter()
+        writer.beginObject()
+        writer.writeMember("string", string)
+        writer.endObject()
+        
+        let object = try JSONSerialization.jsonObject(with: writer.data) as? [String: String]
+        XCTAssertEqual(object?["string"], string)
+    }
+    
+    func testInvalidMemberIsRolledBack() throws {
+        var writer = JSONStreamWriter()
+        writer.beginObject()
+        XCTAssertThrowsError(try writer.writeMember("date", value: Date()))
+        writer.writeMember("first", "1")
+        XCTAssertThrowsError(try writer.writeMember("nested", value: ["valid": 1, "invalid": Double.nan] as [String: Any]))
+        writer.writeMember("second", "2")
+        writer.endObject()
+        
+        XCTAssertEqual(String(decoding: writer.data, as: UTF8.self), #"{"first":"1","second":"2"}"#)
+    }
+    
+    func testDuplicatedContextKeepsLastPayload() throws {
+        let event = Upstream.Event(
+            payload: [:],
+            header: Upstream.Header(namespace: "ASR", name: "Recognize", version: "1.0", dialogRequestId: "dialog-request-id", messageId: "message-id"),
+            contextPayload: [
+                ContextInfo(contextType: .capability, name: "ASR", payload: ["version": "1.0"]),
+                ContextInfo(contextType: .client, name: "wakeupWord", payload: "aria"),
+                ContextInfo(contextType: .capability, name: "ASR", payload: ["version": "1.1"]),
+                ContextInfo(contextType: .client, name: "os", payload: "iPadOS"),
+                ContextInfo(contextType: .client, name: "wakeupWord", payload: "tinkerbell")
+            ]
+        )
+        
+        var writer = JSONStreamWriter()
+        event.writeBody(to: &writer)
+        
+        let object = try JSONSerialization.jsonObject(with: writer.data) as? [String: Any]
+        let context = object?["context"] as? NSDictionary
+        XCTAssertEqual(context, [
+            "supportedInterfaces": ["ASR": ["version": "1.1"]],
+            "client": ["os": "iPadOS", "wakeupWord": "tinkerbell"]
+        ] as NSDictionary)
+        
+        // Duplicated names are not written twice.
+        let contextString = String(decoding: writer.data, as: UTF8.self)
+        XCTAssertEqual(contextString.components(separatedBy: #""ASR":"#).count, 2)
+        XCTAssertEqual(contextString.components(separatedBy: #""wakeupWord":"#).count, 2)
+    }
+    
+    func testBoolIsDistinguishedFromCharNumber() throws {
+        var writer = JSONStreamWriter()
+        writer.beginObject()
+        try writer.writeMember("bool", value: NSNumber(value: false))
+        try writer.writeMember("char", value: NSNumber(value: Int8(1)))
+        writer.endObject()
+        
+        XCTAssertEqual(String(decoding: writer.data, as: UTF8.self), #"{"bool":false,"char":1}"#)
+    }
+}
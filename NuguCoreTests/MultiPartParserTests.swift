@@ -0,0 +1,270 @@
+//
+//  MultiPartParserTests.swift
+//  NuguCoreTests
+//
+//  Created by agent on 2026/10/17.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+
+@testable import NuguCore
+
+final class MultiPartParserTests: XCTestCase {
+    private let boundary = "this-is-a-boundary"
+    private let directiveBody = Data(#"{"directives":[]}"#.utf8)
+    private let attachmentBody = Data((0..<300).map { UInt8($0 % 256) })
+    
+    func testParseWholeMessage() {
+        let parser = MultiPartParser(boundary: boundary)
+        let parts = parser.parse(data: makeMessage()).compactMap { try? $0.get() }
+        
+        XCTAssertEqual(parts.count, 2)
+        XCTAssertEqual(parts[0].header[.contentType], "application/json")
+        XCTAssertEqual(parts[0].body.data, directiveBody)
+        XCTAssertTrue(parts[0].isCompleted)
+        XCTAssertEqual(parts[1].header[.filename], "0;end")
+        XCTAssertEqual(parts[1].header["message-id"], "attachment-message-id")
+        XCTAssertEqual(parts[1].body.data, attachmentBody)
+        XCTAssertTrue(parts[1].isCompleted)
+    }
+    
+    func testParseChunksOfEverySize() {
+        let message = makeMessage()
+        
+        for chunkSize in 1...message.count {
+            let parser = MultiPartParser(boundary: boundary)
+            var parts = [MultiPartParser.Part]()
+            for chunk in split(message, by: chunkSize) {
+                parts += parser.parse(data: chunk).compactMap { try? $0.get() }
+            }
+            
+            XCTAssertEqual(parts.map { $0.body.data }, [directiveBody, attachmentBody], "chunk size: \(chunkSize)")
+            XCTAssertEqual(parts.map { $0.header[.contentLength] }, ["\(directiveBody.count)", "\(attachmentBody.count)"])
+        }
+    }
+    
+    func testParseBoundaryStraddlingChunks() {
+        let message = makeMessage()
+        let delimiter = Data("\r\n--\(boundary)\r\n".utf8)
+        let delimiterRange = message.range(of: delimiter)!
+        
+        // Split the message at every byte around the delimiter between parts.
+        for splitIndex in (delimiterRange.lowerBound - 1)...(delimiterRange.upperBound + 1) {
+            let parser = MultiPartParser(boundary: boundary)
+            let parts = (parser.parse(data: message[..<splitIndex]) + parser.parse(data: message[splitIndex...]))
+                .compactMap { try? $0.get() }
+            
+            XCTAssertEqual(parts.map { $0.body.data }, [directiveBody, attachmentBody], "split at \(splitIndex)")
+        }
+    }
+    
+    func testBodyIsNotCopied() {
+        let message = makeMessage()
+        let parser = MultiPartParser(boundary: boundary)
+        let parts = parser.parse(data: message).compactMap { try? $0.get() }
+        
+        // The body of one chunk is the slice of it.
+        let body = parts[1].body
+        XCTAssertEqual(body.segments.count, 1)
+        XCTAssertEqual(
+            body.segments[0].withUnsafeBytes { $0.baseAddress },
+            message.withUnsafeBytes { $0.baseAddress.map { $0 + body.segments[0].startIndex } }
+        )
+    }
+    
+    func testStreamingPartIsEmittedAsFragments() {
+        let parser = MultiPartParser(boundary: boundary) { header in
+            header[.contentType]?.contains("application/json") == false
+        }
+        var directiveParts = [MultiPartParser.Part]()
+        var fragments = [MultiPartParser.Part]()
+        
+        for chunk in split(makeMessage(), by: 64) {
+            for part in parser.parse(data: chunk).compactMap({ try? $0.get() }) {
+                if part.header[.contentType] == "application/json" {
+                    directiveParts.append(part)
+                } else {
+                    fragments.append(part)
+                }
+            }
+        }
+        
+        XCTAssertEqual(directiveParts.count, 1)
+        XCTAssertEqual(directiveParts.first?.isCompleted, true)
+        XCTAssertLessThan(1, fragments.count)
+        XCTAssertEqual(fragments.map { $0.isCompleted }, Array(repeating: false, count: fragments.count - 1) + [true])
+        
+        var streamedBody = Data()
+        fragments.forEach { streamedBody.append($0.body.data) }
+        XCTAssertEqual(streamedBody, attachmentBody)
+    }
+    
+    func testParserResumesAfterMalformedPart() {
+        var message = Data("--\(boundary)\r\nInvalid header line\r\n\r\n".utf8)
+        message.append(makeMessage())
+        
+        let parser = MultiPartParser(boundary: boundary)
+        let results = parser.parse(data: message)
+        
+        XCTAssertEqual(results.count, 3)
+        XCTAssertThrowsError(try results[0].get())
+        XCTAssertEqual(results.dropFirst().compactMap { try? $0.get().body.data }, [directiveBody, attachmentBody])
+    }
+    
+    func testPartWithoutContentLengthIsReported() {
+        let message = Data("--\(boundary)\r\nContent-Type: application/json\r\n\r\n{}\r\n--\(boundary)--\r\n".utf8)
+        
+        let parser = MultiPartParser(boundary: boundary)
+        let results = parser.parse(data: message)
+        
+        XCTAssertEqual(results.count, 1)
+        XCTAssertThrowsError(try results[0].get())
+    }
+    
+    func testCompressedPartsAreInflatedInUnevenChunks() {
+        let message = makeCompressedMessage()
+        let expectedBodies = [directiveBody, attachmentBody, attachmentBody]
+        
+        for chunkSizes in [[1], [1, 7, 3, 61, 2, 19], [13, 5, 128, 1], [message.count]] {
+            let parser = MultiPartParser(boundary: boundary)
+            var parts = [MultiPartParser.Part]()
+            for chunk in split(message, by: chunkSizes) {
+                parts += parser.parse(data: chunk).compactMap { try? $0.get() }
+            }
+            
+            XCTAssertEqual(parts.map { $0.body.data }, expectedBodies, "chunk sizes: \(chunkSizes)")
+            XCTAssertEqual(parts.map { $0.header[.contentEncoding] }, ["gzip", "deflate", "deflate"])
+        }
+    }
+    
+    func testCompressedStreamingPartIsEmittedAsInflatedFragments() {
+        let parser = MultiPartParser(boundary: boundary) { header in
+            header[.contentType]?.contains("application/json") == false
+        }
+        var fragments = [MultiPartParser.Part]()
+        
+        for chunk in split(makeCompressedMessage(), by: [5, 31, 2, 17]) {
+            fragments += parser.parse(data: chunk).compactMap { try? $0.get() }.filter { $0.header[.contentType] != "application/json" }
+        }
+        
+        // The fragments of the zlib wrapped part and then the raw deflate part.
+        let lastFragmentIndices = fragments.indices.filter { fragments[$0].isCompleted }
+        XCTAssertEqual(lastFragmentIndices.count, 2)
+        XCTAssertEqual(lastFragmentIndices.last, fragments.count - 1)
+        
+        var streamedBody = Data()
+        fragments.forEach { streamedBody.append($0.body.data) }
+        XCTAssertEqual(streamedBody, attachmentBody + attachmentBody)
+    }
+    
+    func testParserResumesAfterInvalidEncoding() {
+        let corruptedBody = Data(repeating: 0xff, count: 64)
+        var message = makePart(header: "Content-Type: application/json\r\nContent-Encoding: br\r\n", body: CompressedData.deflate(directiveBody))
+        message.append(makePart(header: "Content-Type: application/json\r\nContent-Encoding: deflate\r\n", body: corruptedBody))
+        message.append(makePart(header: "Content-Type: application/json\r\nContent-Encoding: gzip\r\n", body: CompressedData.zlib(directiveBody)))
+        message.append(makeCompressedMessage())
+        
+        for chunkSizes in [[1, 7, 3, 61, 2, 19], [message.count]] {
+            let parser = MultiPartParser(boundary: boundary)
+            var results = [Result<MultiPartParser.Part, Error>]()
+            for chunk in split(message, by: chunkSizes) {
+                results += parser.parse(data: chunk)
+            }
+            
+            // Unsupported encoding, corrupted deflate body and not a gzip body.
+            let errors = results.compactMap { result -> Error? in
+                guard case let .failure(error) = result else { return nil }
+                
+                return error
+            }
+            XCTAssertEqual(errors.map { $0 as? MultiPartParserError }, [.invalidEncoding, .invalidEncoding, .invalidEncoding], "chunk sizes: \(chunkSizes)")
+            XCTAssertEqual(results.compactMap { try? $0.get().body.data }, [directiveBody, attachmentBody, attachmentBody])
+        }
+    }
+    
+    func testParsePerformance() {
+        let parts = (0..<256).map { makePart(header: attachmentHeader(seq: $0, isEnd: $0 == 255), body: Data(count: 4 * 1024)) }
+        var message = Data()
+        parts.forEach { message.append($0) }
+        message.append(Data("--\(boundary)--\r\n".utf8))
+        let chunks = split(message, by: 16 * 1024)
+        
+        measure {
+            let parser = MultiPartParser(boundary: boundary)
+            let partCount = chunks.reduce(0) { $0 + parser.parse(data: $1).count }
+            XCTAssertEqual(partCount, parts.count)
+        }
+    }
+}
+
+// MARK: - Private
+
+private extension MultiPartParserTests {
+    func makeMessage() -> Data {
+        var message = Data("preamble\r\n".utf8)
+        message.append(makePart(header: "Content-Type: application/json\r\n", body: directiveBody))
+        message.append(makePart(header: attachmentHeader(seq: 0, isEnd: true), body: attachmentBody))
+        message.append(Data("--\(boundary)--\r\n".utf8))
+        
+        return message
+    }
+    
+    /// The gzip directive, the zlib wrapped attachment and the raw deflate attachment.
+    func makeCompressedMessage() -> Data {
+        var message = makePart(
+            header: "Content-Type: application/json\r\nContent-Encoding: gzip\r\n",
+            body: CompressedData.gzip(directiveBody, name: "directive.json", hasHeaderCRC: true)
+        )
+        message.append(makePart(header: attachmentHeader(seq: 0, isEnd: false) + "Content-Encoding: deflate\r\n", body: CompressedData.zlib(attachmentBody)))
+        message.append(makePart(header: attachmentHeader(seq: 1, isEnd: true) + "Content-Encoding: deflate\r\n", body: CompressedData.deflate(attachmentBody)))
+        message.append(Data("--\(boundary)--\r\n".utf8))
+        
+        return message
+    }
+    
+    func attachmentHeader(seq: Int, isEnd: Bool) -> String {
+        return "Content-Type: audio/opus\r\n"
+            + "Filename: \(seq);\(isEnd ? "end" : "continued")\r\n"
+            + "Message-Id: attachment-message-id\r\n"
+    }
+    
+    func makePart(header: String, body: Data) -> Data {
+        var part = Data("--\(boundary)\r\n\(header)Content-Length: \(body.count)\r\n\r\n".utf8)
+        part.append(body)
+        part.append(Data("\r\n".utf8))
+        
+        return part
+    }
+    
+    func split(_ data: Data, by chunkSize: Int) -> [Data] {
+        return stride(from: 0, to: data.count, by: chunkSize).map {
+            Data(data[$0..<min($0 + chunkSize, data.count)])
+        }
+    }
+    
+    /// Splits the data by the sizes in turn.
+    func split(_ data: Data, by chunkSizes: [Int]) -> [Data] {
+        var chunks = [Data]()
+        var index = 0
+        while index < data.count {
+            let chunkSize = min(chunkSizes[chunks.count % chunkSizes.count], data.count - index)
+            chunks.append(Data(data[index..<(index + chunkSize)]))
+            index += chunkSize
+        }
+        
+        return chunks
+    }
+}
@@ -0,0 +1,62 @@
+//
+//  MultiPartWriterTests.swift
+//  NuguCoreTests
+//
+//  Created by agent on 2026/10/17.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+
+@testable import NuguCore
+
+/// The written part has no `Content-Length`, so it is checked by the bytes instead of `MultiPartParser`.
+final class MultiPartWriterTests: XCTestCase {
+    private let boundary = "this-is-a-boundary"
+    
+    func testEventPart() {
+        let writer = MultiPartWriter(boundary: boundary)
+        let part = writer.eventPart(body: Data("{}".utf8))
+        
+        XCTAssertEqual(String(decoding: part.data, as: UTF8.self), "--\(boundary)\r\n" + eventHeader + "{}\r\n--\(boundary)\r\n")
+    }
+    
+    func testBatchedEventPartsAreNotSeparatedByEmptyPart() {
+        let writer = MultiPartWriter(boundary: boundary)
+        let bodies = ["{\"seq\":0}", "{\"seq\":1}", "{\"seq\":2}"].map { Data($0.utf8) }
+        var message = writer.eventParts(bodies: bodies).data
+        message.append(writer.attachmentPart(seq: 0, isEnd: true, type: "audio/speex", messageId: "message-id", content: Data([0x01, 0x02])).data)
+        message.append(writer.closePart.data)
+        
+        let text = String(decoding: message, as: UTF8.self)
+        XCTAssertEqual(text.components(separatedBy: "--\(boundary)\r\n").count - 1, 5)
+        XCTAssertFalse(text.contains("--\(boundary)\r\n--\(boundary)"))
+        XCTAssertEqual(text.components(separatedBy: eventHeader).count - 1, bodies.count)
+        
+        var expectedText = "--\(boundary)\r\n"
+        bodies.forEach {
+            expectedText += eventHeader + String(decoding: $0, as: UTF8.self) + "\r\n--\(boundary)\r\n"
+        }
+        XCTAssertTrue(text.hasPrefix(expectedText))
+    }
+}
+
+// MARK: - Private
+
+private extension MultiPartWriterTests {
+    var eventHeader: String {
+        return "Content-Disposition: form-data; name=\"event\"\r\nContent-Type: application/json\r\n\r\n"
+    }
+}
@@ -0,0 +1,123 @@
+//
+//  PartBodyInflaterTests.swift
+//  NuguCoreTests
+//
+//  Created by agent on 2026/10/17.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+
+@testable import NuguCore
+
+final class PartBodyInflaterTests: XCTestCase {
+    private let body = DirectiveFixtures.displayTemplate
+    
+    func testGzipWithOptionalHeaderFields() throws {
+        let compressedBodies = [
+            CompressedData.gzip(body),
+            CompressedData.gzip(body, extra: Data(repeating: 0xAB, count: 300)),
+            CompressedData.gzip(body, name: "directive.json"),
+            CompressedData.gzip(body, comment: "stand-in"),
+            CompressedData.gzip(body, hasHeaderCRC: true),
+            CompressedData.gzip(body, extra: Data([1, 2, 3]), name: "directive.json", comment: "stand-in", hasHeaderCRC: true)
+        ]
+        
+        for (index, compressedBody) in compressedBodies.enumerated() {
+            XCTAssertEqual(try inflate([compressedBody], contentEncoding: "gzip"), body, "case: \(index)")
+        }
+    }
+    
+    func testGzipHeaderSplitAcrossChunks() throws {
+        let compressedBody = CompressedData.gzip(body, extra: Data([1, 2, 3]), name: "directive.json", comment: "stand-in", hasHeaderCRC: true)
+        
+        // The header is 41 bytes. Every field and length of it is split.
+        for chunkSize in 1...48 {
+            XCTAssertEqual(try inflate(split(compressedBody, by: chunkSize), contentEncoding: "gzip"), body, "chunk size: \(chunkSize)")
+        }
+        
+        // The header is split at every byte and the rest comes at once.
+        for splitIndex in 1...48 {
+            let chunks = [compressedBody.prefix(splitIndex), compressedBody.dropFirst(splitIndex)]
+            XCTAssertEqual(try inflate(chunks, contentEncoding: "gzip"), body, "split at \(splitIndex)")
+        }
+    }
+    
+    func testZlibWrappedAndRawDeflate() throws {
+        let zlibBody = CompressedData.zlib(body)
+        let rawBody = CompressedData.deflate(body)
+        
+        XCTAssertEqual(try inflate([zlibBody], contentEncoding: "deflate"), body)
+        XCTAssertEqual(try inflate([rawBody], contentEncoding: "deflate"), body)
+        
+        // The zlib header is split between the two bytes.
+        XCTAssertEqual(try inflate(split(zlibBody, by: 1), contentEncoding: "deflate"), body)
+        XCTAssertEqual(try inflate(split(rawBody, by: 1), contentEncoding: "deflate"), body)
+    }
+    
+    func testContentEncodingIsCaseInsensitive() throws {
+        XCTAssertEqual(try inflate([CompressedData.gzip(body)], contentEncoding: " GZIP "), body)
+        XCTAssertNil(PartBodyInflater(contentEncoding: "br"))
+        XCTAssertNil(PartBodyInflater(contentEncoding: "identity"))
+    }
+    
+    func testTruncatedBodyIsNotFinished() throws {
+        let compressedBody = CompressedData.gzip(body)
+        let inflater = try XCTUnwrap(PartBodyInflater(contentEncoding: "gzip"))
+        
+        _ = try inflater.inflate(compressedBody.prefix(compressedBody.count / 2))
+        XCTAssertThrowsError(try inflater.finish()) { error in
+            XCTAssertEqual(error as? MultiPartParserError, .endOfData)
+        }
+    }
+    
+    func testInvalidBodyIsReported() throws {
+        let invalidBodies: [(contentEncoding: String, body: Data)] = [
+            // Not a gzip magic.
+            ("gzip", CompressedData.zlib(body)),
+            // zlib header with the preset dictionary.
+            ("deflate", Data([0x78, 0xbb]) + CompressedData.deflate(body)),
+            // Reserved block type of deflate.
+            ("deflate", Data(repeating: 0xff, count: 64))
+        ]
+        
+        for (index, invalidBody) in invalidBodies.enumerated() {
+            XCTAssertThrowsError(try inflate([invalidBody.body], contentEncoding: invalidBody.contentEncoding), "case: \(index)") { error in
+                XCTAssertEqual(error as? MultiPartParserError, .invalidEncoding)
+            }
+        }
+    }
+}
+
+// MARK: - Private
+
+private extension PartBodyInflaterTests {
+    func inflate(_ chunks: [Data], contentEncoding: String) throws -> Data {
+        let inflater = try XCTUnwrap(PartBodyInflater(contentEncoding: contentEncoding))
+        var inflatedData = Data()
+        for chunk in chunks {
+            inflatedData.append(try inflater.inflate(chunk))
+        }
+        try inflater.finish()
+        
+        return inflatedData
+    }
+    
+    func split(_ data: Data, by chunkSize: Int) -> [Data] {
+        return stride(from: 0, to: data.count, by: chunkSize).map {
+            Data(data[$0..<min($0 + chunkSize, data.count)])
+        }
+    }
+}
@@ -20,9 +20,20 @@
 
 import Foundation
 
+/**
+ InputStream which is fed by appending data.
+ 
+ Appended data are kept in the queue as they are (not copied) and the read cursor moves forward through the queue.
+ */
 public class DataBoundInputStream: InputStream {
-    @Atomic private var data: Data
+    @Atomic private var chunks = ChunkQueue()
     @Atomic var isLastDataAppended = false
+    @Atomic private var isOverHighWatermark = false
+    
+    /// Limits of the bytes which are appended but not read yet. `watermarkHandler` is not called if it is nil.
+    @Atomic public var watermark: Watermark?
+    /// Called when the buffered bytes reach the high watermark and when they drain to the low watermark.
+    public var watermarkHandler: ((_ isOverHighWatermark: Bool, _ bufferedCount: Int) -> Void)?
     @Atomic private var internalProperty = [Stream.PropertyKey: Any?]()
     private var runLoop = RunLoop.main
     private var runLoopMode = RunLoop.Mode.default
@@ -50,15 +61,15 @@ public class DataBoundInputStream: InputStream {
     }
     
     public override init(data: Data) {
-        self.data = data
         super.init(data: data)
+        chunks.append(data)
     }
     
     public override func open() {
         internalStatus = .open
         notify(event: .openCompleted)
 
-        if 0 < data.count {
+        if 0 < chunks.count {
             notify(event: .hasBytesAvailable)
         }
     }
@@ -70,13 +81,12 @@ public class DataBoundInputStream: InputStream {
     public override func read(_ buffer: UnsafeMutablePointer<UInt8>, maxLength len: Int) -> Int {
         internalStatus = .reading
         
-        var popData: Data?
-        _data.mutate {
-            let length = min($0.count, len)
-            guard 0 < length else { return }
-            
-            popData = $0[..<length]
-            $0.removeSubrange(..<length)
+        var readLength = 0
+        var bufferedCount = 0
+        _chunks.mutate {
+            readLength = $0.read(into: buffer, maxLength: len)
+            bufferedCount = $0.count
+            guard 0 < readLength else { return }
             
             switch $0.count {
             case 0 where isLastDataAppended:
@@ -91,25 +101,32 @@ public class DataBoundInputStream: InputStream {
                 internalStatus = .open
             }
         }
-        guard let readData = popData else { return 0 }
-
-        readData.copyBytes(to: buffer, from: 0..<readData.count)
-        return readData.count
+        
+        updateWatermarkState(bufferedCount: bufferedCount)
+        return readLength
     }
     
+    /// Exposes the unread bytes of the first chunk without copying. It is valid until the next read.
     public override func getBuffer(_ buffer: UnsafeMutablePointer<UnsafeMutablePointer<UInt8>?>, length len: UnsafeMutablePointer<Int>) -> Bool {
-        guard 0 < data.count else { return false }
+        var headBuffer: UnsafeRawBufferPointer?
+        _chunks.mutate {
+            headBuffer = $0.head
+        }
+        guard let head = headBuffer, let baseAddress = head.baseAddress, 0 < head.count else { return false }
         
-        let copiedBuffer = UnsafeMutablePointer<UInt8>.allocate(capacity: data.count)
-        data.copyBytes(to: copiedBuffer, from: 0..<data.count)
-        buffer.pointee = copiedBuffer
-        len.pointee = data.count
+        buffer.pointee = UnsafeMutablePointer(mutating: baseAddress.assumingMemoryBound(to: UInt8.self))
+        len.pointee = head.count
         
         return true
     }
     
     public override var hasBytesAvailable: Bool {
-        return 0 < data.count
+        return 0 < chunks.count
+    }
+    
+    /// The number of bytes which are appended but not read yet.
+    public var bufferedCount: Int {
+        return chunks.count
     }
 
     public override func schedule(in aRunLoop: RunLoop, forMode mode: RunLoop.Mode) {
@@ -148,19 +165,146 @@ extension DataBoundInputStream {
     public func appendData(_ other: Data) {
         guard isLastDataAppended == false else { return }
 
-        self._data.mutate {
+        var bufferedCount = 0
+        self._chunks.mutate {
             $0.append(other)
+            bufferedCount = $0.count
+        }
+        
+        notify(event: .hasBytesAvailable)
+        updateWatermarkState(bufferedCount: bufferedCount)
+    }
+    
+    /// Appends the segments at once and notify only one `hasBytesAvailable` event.
+    public func appendData(_ segments: SegmentedData) {
+        guard isLastDataAppended == false else { return }
+        
+        var bufferedCount = 0
+        self._chunks.mutate { chunks in
+            segments.segments.forEach { chunks.append($0) }
+            bufferedCount = chunks.count
         }
         
         notify(event: .hasBytesAvailable)
+        updateWatermarkState(bufferedCount: bufferedCount)
     }
     
     public func lastDataAppended() {
         isLastDataAppended = true
 
-        if data.count == 0 {
+        if chunks.count == 0 {
             internalStatus = .atEnd
             notify(event: .endEncountered)
         }
     }
 }
+
+// MARK: - Watermark
+
+public extension DataBoundInputStream {
+    /// The buffered bytes are regarded as piled up from `high` until they drain to `low`.
+    struct Watermark {
+        public let high: Int
+        public let low: Int
+        
+        public init(high: Int, low: Int) {
+            self.high = high
+            self.low = min(low, high)
+        }
+    }
+}
+
+private extension DataBoundInputStream {
+    func updateWatermarkState(bufferedCount: Int) {
+        guard let watermark = watermark else { return }
+        
+        var changedState: Bool?
+        _isOverHighWatermark.mutate {
+            switch $0 {
+            case false where watermark.high <= bufferedCount:
+                $0 = true
+                changedState = true
+            case true where bufferedCount <= watermark.low:
+                $0 = false
+                changedState = false
+            default:
+                break
+            }
+        }
+        
+        guard let isOverHighWatermark = changedState else { return }
+        watermarkHandler?(isOverHighWatermark, bufferedCount)
+    }
+}
+
+// MARK: - ChunkQueue
+
+private extension DataBoundInputStream {
+    /**
+     Queue of immutable chunks with the read cursor.
+     
+     Chunks are kept as `NSData` so that the address of bytes is stable while the chunk is in the queue.
+     */
+    struct ChunkQueue {
+        private var chunks = [NSData]()
+        private var headIndex = 0
+        private var headOffset = 0
+        /// The number of unread bytes.
+        private(set) var count = 0
+        
+        mutating func append(_ chunk: Data) {
+            guard 0 < chunk.count else { return }
+            
+            chunks.append(chunk as NSData)
+            count += chunk.count
+        }
+        
+        /// Unread bytes of the first chunk.
+        var head: UnsafeRawBufferPointer? {
+            guard headIndex < chunks.count else { return nil }
+            
+            let chunk = chunks[headIndex]
+            return UnsafeRawBufferPointer(start: chunk.bytes + headOffset, count: chunk.length - headOffset)
+        }
+        
+        /// Copies only the requested bytes and moves the cursor forward.
+        mutating func read(into buffer: UnsafeMutablePointer<UInt8>, maxLength: Int) -> Int {
+            var readLength = 0
+            
+            while readLength < maxLength, headIndex < chunks.count {
+                let chunk = chunks[headIndex]
+                let length = min(maxLength - readLength, chunk.length - headOffset)
+                chunk.getBytes(buffer + readLength, range: NSRange(location: headOffset, length: length))
+                
+                readLength += length
+                headOffset += length
+                if headOffset == chunk.length {
+                    headIndex += 1
+                    headOffset = 0
+                }
+            }
+            
+            count -= readLength
+            compactIfNeeded()
+            return readLength
+        }
+        
+        /// Drops the chunks which have been read. It is amortized O(1) per chunk.
+        private mutating func compactIfNeeded() {
+            if count == 0 {
+                chunks.removeAll(keepingCapacity: true)
+                headIndex = 0
+                return
+            }
+            
+            guard Const.compactThreshold <= headIndex, chunks.count <= headIndex * 2 else { return }
+            
+            chunks.removeFirst(headIndex)
+            headIndex = 0
+        }
+        
+        private enum Const {
+            static let compactThreshold = 32
+        }
+    }
+}
@@ -0,0 +1,175 @@
+//
+//  ModelFileRegistry.swift
+//  NuguUtils
+//
+//  Created by agent on 2026/10/17.
+//  Copyright © 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/**
+ Registry of the model files which are memory mapped in advance, so the engine reads them from the page cache.
+ 
+ The engine libraries take the path of a model file and read it by themselves. The mapping is not passed to them.
+ So the registry maps the file and pages it in on the background queue, then the engine reads it without waiting for the disk.
+ The mapping is kept resident and reported by `loadedModelFiles` until it is unloaded. (ex. the keyword is replaced)
+ All the mappings are unloaded when the system is low on memory, then the engines read the files by themselves.
+ The pages are backed by the file, so the system can reclaim them without swapping.
+ */
+public final class ModelFileRegistry {
+    public static let shared = ModelFileRegistry()
+    
+    private let loadQueue = DispatchQueue(label: "com.sktelecom.romaine.utils.model_file_registry", qos: .utility)
+    @Atomic private var modelFiles = [String: ModelFile]()
+    private let memoryPressureSource: DispatchSourceMemoryPressure
+    
+    /// The model files loaded.
+    public var loadedModelFiles: [ModelFile] {
+        return Array(modelFiles.values)
+    }
+    
+    /// The total size of the model files resident in the memory.
+    public var residentSize: Int {
+        return loadedModelFiles.reduce(0) { $0 + $1.residentSize }
+    }
+    
+    init() {
+        memoryPressureSource = DispatchSource.makeMemoryPressureSource(eventMask: [.warning, .critical], queue: loadQueue)
+        memoryPressureSource.setEventHandler { [weak self] in
+            self?._modelFiles.mutate {
+                $0.removeAll()
+            }
+        }
+        memoryPressureSource.resume()
+    }
+    
+    /**
+     Loads the model files on the background queue. The files loaded already are skipped.
+     
+     - Parameter paths: The paths of model files.
+     - Parameter completion: Called on the background queue with the loaded ones or the first error.
+     */
+    public func preload(paths: [String], completion: ((Result<[ModelFile], Error>) -> Void)? = nil) {
+        loadQueue.async { [weak self] in
+            guard let self = self else { return }
+            
+            let result = Result<[ModelFile], Error> {
+                try paths.map { try self.internalLoad(path: $0) }
+            }
+            completion?(result)
+        }
+    }
+    
+    /**
+     Returns the model file if it is loaded already.
+     
+     It doesn't wait for the loading in progress, because it is called on the audio queue of the engine.
+     The engine reads the file by itself if it is not loaded yet.
+     */
+    public func loadedModelFile(path: String) -> ModelFile? {
+        return modelFiles[path]
+    }
+    
+    /// The mapping is removed when no one keeps the model file.
+    public func unload(path: String) {
+        _modelFiles.mutate {
+            $0[path] = nil
+        }
+    }
+}
+
+// MARK: - ModelFile
+
+public extension ModelFileRegistry {
+    enum ModelFileError: Error {
+        case notFound(path: String)
+        case invalidFile(path: String)
+    }
+    
+    final class ModelFile {
+        public let path: String
+        public let size: Int
+        /// The time taken to map and page in the file.
+        public let loadTime: TimeInterval
+        private let buffer: UnsafeMutableRawPointer
+        /// Sum of the first byte of each page. It keeps the page-in reads from being optimized out.
+        private let pageSum: UInt8
+        
+        init(path: String) throws {
+            let startTime = DispatchTime.now()
+            
+            let fileDescriptor = open(path, O_RDONLY)
+            guard 0 <= fileDescriptor else {
+                throw ModelFileError.notFound(path: path)
+            }
+            defer { close(fileDescriptor) }
+            
+            var fileStatus = stat()
+            guard fstat(fileDescriptor, &fileStatus) == 0,
+                fileStatus.st_mode & S_IFMT == S_IFREG,
+                0 < fileStatus.st_size,
+                let mappedBuffer = mmap(nil, Int(fileStatus.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0),
+                mappedBuffer != MAP_FAILED else {
+                    throw ModelFileError.invalidFile(path: path)
+            }
+            
+            self.path = path
+            size = Int(fileStatus.st_size)
+            buffer = mappedBuffer
+            
+            madvise(buffer, size, MADV_WILLNEED)
+            var pageSum: UInt8 = 0
+            for offset in stride(from: 0, to: size, by: Int(getpagesize())) {
+                pageSum &+= buffer.load(fromByteOffset: offset, as: UInt8.self)
+            }
+            self.pageSum = pageSum
+            
+            loadTime = TimeInterval(DispatchTime.now().uptimeNanoseconds - startTime.uptimeNanoseconds) / 1_000_000_000
+        }
+        
+        deinit {
+            munmap(buffer, size)
+        }
+        
+        /// The size of the pages resident in the memory now.
+        public var residentSize: Int {
+            let pageSize = Int(getpagesize())
+            var pageStates = [CChar](repeating: 0, count: (size + pageSize - 1) / pageSize)
+            let result = pageStates.withUnsafeMutableBufferPointer {
+                mincore(buffer, size, $0.baseAddress)
+            }
+            guard result == 0 else { return 0 }
+            
+            return pageStates.filter { $0 & CChar(MINCORE_INCORE) != 0 }.count * pageSize
+        }
+    }
+}
+
+// MARK: - Private
+
+private extension ModelFileRegistry {
+    func internalLoad(path: String) throws -> ModelFile {
+        if let modelFile = modelFiles[path] {
+            return modelFile
+        }
+        
+        let modelFile = try ModelFile(path: path)
+        _modelFiles.mutate {
+            $0[path] = modelFile
+        }
+        return modelFile
+    }
+}
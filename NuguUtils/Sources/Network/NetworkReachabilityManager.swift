@@ -22,6 +22,8 @@
 import Foundation
 import SystemConfiguration
 
+import RxSwift
+
 public final class NetworkReachabilityManager {
     public static let shared = NetworkReachabilityManager()
     
@@ -36,6 +38,14 @@ public final class NetworkReachabilityManager {
         return flags.isActuallyReachable
     }
     
+    /// Emits `isReachable` when the reachability is changed.
+    public var reachabilityChanged: Observable<Bool> {
+        return reachabilitySubject.distinctUntilChanged()
+    }
+    
+    private let reachabilitySubject = PublishSubject<Bool>()
+    private let reachabilityQueue = DispatchQueue(label: "com.sktelecom.romaine.utils.network_reachability")
+    
     private var reachability: SCNetworkReachability? = {
         var zeroAddress = sockaddr()
         zeroAddress.sa_len = UInt8(MemoryLayout<sockaddr>.size)
@@ -43,7 +53,27 @@ public final class NetworkReachabilityManager {
         return SCNetworkReachabilityCreateWithAddress(nil, &zeroAddress)
     }()
     
-    private init() {}
+    private init() {
+        guard let reachability = reachability else { return }
+        
+        // The shared instance is never released. So it is not retained by the context.
+        var context = SCNetworkReachabilityContext(
+            version: 0,
+            info: Unmanaged.passUnretained(self).toOpaque(),
+            retain: nil,
+            release: nil,
+            copyDescription: nil
+        )
+        let callback: SCNetworkReachabilityCallBack = { _, flags, info in
+            guard let info = info else { return }
+            
+            let manager = Unmanaged<NetworkReachabilityManager>.fromOpaque(info).takeUnretainedValue()
+            manager.reachabilitySubject.onNext(flags.isActuallyReachable)
+        }
+        
+        SCNetworkReachabilitySetCallback(reachability, callback, &context)
+        SCNetworkReachabilitySetDispatchQueue(reachability, reachabilityQueue)
+    }
 }
 
 extension SCNetworkReachabilityFlags {
@@ -0,0 +1,130 @@
+//
+//  RingBuffer.swift
+//  NuguUtils
+//
+//  Created by agent on 2026/10/17.
+//  Copyright © 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+import os.lock
+
+/**
+ Fixed size queue between a single producer and a single consumer. (ex. audio tap and audio engine)
+ 
+ The slots are allocated once, so pushing and popping don't allocate.
+ The lock is held only while an index is moved, so the producer never waits for the consumer's work.
+ When the ring is full, an element is dropped by `overrunPolicy` and `overrunCount` is increased.
+ */
+public final class RingBuffer<Element> {
+    public enum OverrunPolicy {
+        /// Drops the oldest element to keep the latest ones.
+        case dropOldest
+        /// Drops the element being pushed.
+        case dropNewest
+    }
+    
+    public let capacity: Int
+    public let overrunPolicy: OverrunPolicy
+    private let slots: UnsafeMutablePointer<Element?>
+    private let lock = UnsafeMutablePointer<os_unfair_lock>.allocate(capacity: 1)
+    // Number of elements pushed and popped. Accessed in the lock only.
+    private var writeCount = 0
+    private var readCount = 0
+    private var internalOverrunCount = 0
+    
+    public init(capacity: Int, overrunPolicy: OverrunPolicy) {
+        self.capacity = max(capacity, 1)
+        self.overrunPolicy = overrunPolicy
+        slots = UnsafeMutablePointer<Element?>.allocate(capacity: self.capacity)
+        slots.initialize(repeating: nil, count: self.capacity)
+        lock.initialize(to: os_unfair_lock())
+    }
+    
+    deinit {
+        slots.deinitialize(count: capacity)
+        slots.deallocate()
+        lock.deinitialize(count: 1)
+        lock.deallocate()
+    }
+    
+    public var count: Int {
+        return withLock { writeCount - readCount }
+    }
+    
+    /// The number of elements dropped because the ring was full.
+    public var overrunCount: Int {
+        return withLock { internalOverrunCount }
+    }
+    
+    /**
+     Called by the producer.
+     
+     - Returns: `false` if an element is dropped by `overrunPolicy`.
+     */
+    @discardableResult public func push(_ element: Element) -> Bool {
+        return withLock {
+            let isFull = writeCount - readCount == capacity
+            if isFull {
+                internalOverrunCount += 1
+                switch overrunPolicy {
+                case .dropNewest:
+                    return false
+                case .dropOldest:
+                    readCount += 1
+                }
+            }
+            
+            slots[writeCount % capacity] = element
+            writeCount += 1
+            return isFull == false
+        }
+    }
+    
+    /// Called by the consumer.
+    public func pop() -> Element? {
+        return withLock {
+            guard readCount < writeCount else { return nil }
+            
+            let index = readCount % capacity
+            let element = slots[index]
+            slots[index] = nil
+            readCount += 1
+            return element
+        }
+    }
+    
+    /// Called by the consumer. Pops the elements until the ring is empty.
+    public func drain(_ body: (Element) -> Void) {
+        while let element = pop() {
+            body(element)
+        }
+    }
+    
+    public func removeAll() {
+        drain { _ in }
+    }
+}
+
+// MARK: - Private
+
+private extension RingBuffer {
+    func withLock<T>(_ body: () -> T) -> T {
+        os_unfair_lock_lock(lock)
+        defer { os_unfair_lock_unlock(lock) }
+        
+        return body()
+    }
+}
@@ -0,0 +1,70 @@
+//
+//  SegmentedData.swift
+//  NuguUtils
+//
+//  Created by agent on 2026/10/16.
+//  Copyright © 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import Foundation
+
+/**
+ Bytes which consist of the slices of other `Data`. (ex. network chunks received)
+ 
+ Each segment shares the reference-counted storage of its original `Data`.
+ So bytes are not copied until the contiguous `data` is requested.
+ */
+public struct SegmentedData {
+    public private(set) var segments: [Data]
+    public private(set) var count: Int
+    
+    public init() {
+        segments = []
+        count = 0
+    }
+    
+    public init(_ data: Data) {
+        self.init()
+        append(data)
+    }
+    
+    public var isEmpty: Bool {
+        return count == 0
+    }
+    
+    /// Appends a segment without copying its bytes.
+    public mutating func append(_ segment: Data) {
+        guard 0 < segment.count else { return }
+        
+        segments.append(segment)
+        count += segment.count
+    }
+    
+    /**
+     Contiguous bytes of all segments.
+     
+     It doesn't copy anything when there is only one segment.
+     In that case, the returned data is a slice and its indices may not start from zero.
+     */
+    public var data: Data {
+        guard 1 < segments.count else {
+            return segments.first ?? Data()
+        }
+        
+        var data = Data(capacity: count)
+        segments.forEach { data.append($0) }
+        return data
+    }
+}
@@ -0,0 +1,171 @@
+//
+//  DataBoundInputStreamTests.swift
+//  NuguUtilsTests
+//
+//  Created by agent on 2026/10/17.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+
+@testable import NuguUtils
+
+final class DataBoundInputStreamTests: XCTestCase {
+    func testReadAcrossChunkBoundaries() {
+        let chunks = [1, 7, 3, 16, 2, 9].enumerated().map { (index, count) in
+            Data((0..<count).map { UInt8(truncatingIfNeeded: index * 16 + $0) })
+        }
+        let expectedData = chunks.reduce(Data(), +)
+        
+        for readLength in 1...expectedData.count {
+            let inputStream = DataBoundInputStream(data: Data())
+            chunks.forEach { inputStream.appendData($0) }
+            
+            XCTAssertEqual(read(inputStream, by: readLength), expectedData, "read length: \(readLength)")
+            XCTAssertEqual(inputStream.bufferedCount, 0)
+            XCTAssertFalse(inputStream.hasBytesAvailable)
+        }
+    }
+    
+    func testSegmentsAreReadInOrder() {
+        var segments = SegmentedData(Data("--boundary\r\n".utf8))
+        segments.append(Data("header\r\n\r\n".utf8))
+        segments.append(Data("body".utf8))
+        
+        let inputStream = DataBoundInputStream(data: Data())
+        inputStream.appendData(segments)
+        
+        XCTAssertEqual(inputStream.bufferedCount, segments.count)
+        XCTAssertEqual(read(inputStream, by: 5), segments.data)
+    }
+    
+    func testGetBufferExposesUnreadBytesOfHeadChunk() {
+        let inputStream = DataBoundInputStream(data: Data())
+        inputStream.appendData(Data("head chunk".utf8))
+        inputStream.appendData(Data("next".utf8))
+        
+        XCTAssertEqual(buffer(of: inputStream), Data("head chunk".utf8))
+        
+        var readBuffer = [UInt8](repeating: 0, count: 5)
+        XCTAssertEqual(inputStream.read(&readBuffer, maxLength: readBuffer.count), 5)
+        XCTAssertEqual(buffer(of: inputStream), Data("chunk".utf8))
+        
+        // The buffer is not copied. So it points the same bytes until the next read.
+        XCTAssertEqual(bufferAddress(of: inputStream), bufferAddress(of: inputStream))
+        
+        XCTAssertEqual(inputStream.read(&readBuffer, maxLength: readBuffer.count), 5)
+        XCTAssertEqual(buffer(of: inputStream), Data("next".utf8))
+        
+        XCTAssertEqual(inputStream.read(&readBuffer, maxLength: readBuffer.count), 4)
+        XCTAssertNil(buffer(of: inputStream))
+    }
+    
+    func testWatermarkTransitions() {
+        let inputStream = DataBoundInputStream(data: Data())
+        inputStream.watermark = DataBoundInputStream.Watermark(high: 10, low: 4)
+        var transitions = [(isOverHighWatermark: Bool, bufferedCount: Int)]()
+        inputStream.watermarkHandler = { transitions.append((isOverHighWatermark: $0, bufferedCount: $1)) }
+        var readBuffer = [UInt8](repeating: 0, count: 16)
+        
+        inputStream.appendData(Data(count: 6))
+        XCTAssertTrue(transitions.isEmpty)
+        
+        // Reaches the high watermark.
+        inputStream.appendData(Data(count: 6))
+        XCTAssertEqual(transitions.map { $0.isOverHighWatermark }, [true])
+        XCTAssertEqual(transitions.last?.bufferedCount, 12)
+        
+        // Stays over the high watermark until it drains to the low watermark.
+        inputStream.appendData(Data(count: 6))
+        XCTAssertEqual(inputStream.read(&readBuffer, maxLength: 10), 10)
+        XCTAssertEqual(transitions.count, 1)
+        
+        XCTAssertEqual(inputStream.read(&readBuffer, maxLength: 4), 4)
+        XCTAssertEqual(transitions.map { $0.isOverHighWatermark }, [true, false])
+        XCTAssertEqual(transitions.last?.bufferedCount, 4)
+        
+        // Between the watermarks after drained.
+        inputStream.appendData(Data(count: 5))
+        XCTAssertEqual(transitions.count, 2)
+    }
+    
+    /// Streams 10 minutes of Speex attachment parts through the stream as `EventSender` and `URLSession` do.
+    func testSpeechAttachmentThroughput() {
+        // Speex wideband of quality 8 is 27.8 kbps and one speech data is 100 ms.
+        let speechDataCount = 10 * 60 * 10
+        let speechData = Data(count: 27_800 / 8 / 10)
+        let partHeader = Data((
+            "\r\n--nugusdk.boundary.dialog-request-id\r\n"
+                + "Content-Disposition: form-data; name=\"attachment\"; filename=\"0;continued\"\r\n"
+                + "Content-Type: application/octet-stream\r\n"
+                + "Message-Id: message-id\r\n\r\n"
+        ).utf8)
+        var readBuffer = [UInt8](repeating: 0, count: 16 * 1024)
+        
+        measure {
+            let inputStream = DataBoundInputStream(data: Data())
+            var readCount = 0
+            
+            for index in 0..<speechDataCount {
+                var part = SegmentedData(partHeader)
+                part.append(speechData)
+                inputStream.appendData(part)
+                
+                // The upload reads every few parts.
+                if index % 4 == 3 {
+                    while inputStream.hasBytesAvailable {
+                        readCount += inputStream.read(&readBuffer, maxLength: readBuffer.count)
+                    }
+                }
+            }
+            while inputStream.hasBytesAvailable {
+                readCount += inputStream.read(&readBuffer, maxLength: readBuffer.count)
+            }
+            
+            XCTAssertEqual(readCount, speechDataCount * (partHeader.count + speechData.count))
+        }
+    }
+}
+
+// MARK: - Private
+
+private extension DataBoundInputStreamTests {
+    func read(_ inputStream: DataBoundInputStream, by length: Int) -> Data {
+        var data = Data()
+        var readBuffer = [UInt8](repeating: 0, count: length)
+        while inputStream.hasBytesAvailable {
+            let readLength = inputStream.read(&readBuffer, maxLength: length)
+            data.append(readBuffer, count: readLength)
+        }
+        
+        return data
+    }
+    
+    func buffer(of inputStream: DataBoundInputStream) -> Data? {
+        var buffer: UnsafeMutablePointer<UInt8>?
+        var length = 0
+        guard inputStream.getBuffer(&buffer, length: &length), let baseAddress = buffer else { return nil }
+        
+        return Data(bytes: baseAddress, count: length)
+    }
+    
+    func bufferAddress(of inputStream: DataBoundInputStream) -> UnsafeMutablePointer<UInt8>? {
+        var buffer: UnsafeMutablePointer<UInt8>?
+        var length = 0
+        _ = inputStream.getBuffer(&buffer, length: &length)
+        
+        return buffer
+    }
+}
@@ -0,0 +1,111 @@
+//
+//  RingBufferTests.swift
+//  NuguUtilsTests
+//
+//  Created by agent on 2026/10/17.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+
+@testable import NuguUtils
+
+final class RingBufferTests: XCTestCase {
+    func testElementsArePoppedInOrderAcrossWrapAround() {
+        let ringBuffer = RingBuffer<Int>(capacity: 3, overrunPolicy: .dropNewest)
+        var popped = [Int]()
+        
+        for element in 0..<10 {
+            XCTAssertTrue(ringBuffer.push(element))
+            if element % 2 == 1 {
+                ringBuffer.drain { popped.append($0) }
+            }
+        }
+        
+        XCTAssertEqual(popped, Array(0..<10))
+        XCTAssertNil(ringBuffer.pop())
+        XCTAssertEqual(ringBuffer.overrunCount, 0)
+    }
+    
+    func testDropNewestKeepsTheOldestElements() {
+        let ringBuffer = RingBuffer<Int>(capacity: 2, overrunPolicy: .dropNewest)
+        
+        XCTAssertTrue(ringBuffer.push(0))
+        XCTAssertTrue(ringBuffer.push(1))
+        XCTAssertFalse(ringBuffer.push(2))
+        
+        XCTAssertEqual(ringBuffer.count, 2)
+        XCTAssertEqual(ringBuffer.overrunCount, 1)
+        XCTAssertEqual(ringBuffer.pop(), 0)
+        XCTAssertEqual(ringBuffer.pop(), 1)
+        XCTAssertNil(ringBuffer.pop())
+    }
+    
+    func testDropOldestKeepsTheLatestElements() {
+        let ringBuffer = RingBuffer<Int>(capacity: 2, overrunPolicy: .dropOldest)
+        
+        XCTAssertTrue(ringBuffer.push(0))
+        XCTAssertTrue(ringBuffer.push(1))
+        XCTAssertFalse(ringBuffer.push(2))
+        
+        XCTAssertEqual(ringBuffer.count, 2)
+        XCTAssertEqual(ringBuffer.overrunCount, 1)
+        XCTAssertEqual(ringBuffer.pop(), 1)
+        XCTAssertEqual(ringBuffer.pop(), 2)
+        XCTAssertNil(ringBuffer.pop())
+    }
+    
+    func testRemoveAllReleasesTheElements() {
+        let ringBuffer = RingBuffer<NSObject>(capacity: 4, overrunPolicy: .dropOldest)
+        weak var weakElement: NSObject?
+        
+        autoreleasepool {
+            let element = NSObject()
+            weakElement = element
+            ringBuffer.push(element)
+        }
+        XCTAssertNotNil(weakElement)
+        
+        ringBuffer.removeAll()
+        XCTAssertNil(weakElement)
+        XCTAssertEqual(ringBuffer.count, 0)
+    }
+    
+    func testSingleProducerAndSingleConsumer() {
+        let elementCount = 100_000
+        let ringBuffer = RingBuffer<Int>(capacity: 64, overrunPolicy: .dropNewest)
+        let producerFinished = expectation(description: "producer finished")
+        var popped = [Int]()
+        popped.reserveCapacity(elementCount)
+        
+        DispatchQueue.global().async {
+            var element = 0
+            while element < elementCount {
+                // The element dropped by the full ring is pushed again.
+                if ringBuffer.push(element) {
+                    element += 1
+                }
+            }
+            producerFinished.fulfill()
+        }
+        
+        while popped.count < elementCount {
+            ringBuffer.drain { popped.append($0) }
+        }
+        
+        wait(for: [producerFinished], timeout: 10)
+        XCTAssertEqual(popped, Array(0..<elementCount))
+    }
+}
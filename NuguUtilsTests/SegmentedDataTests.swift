@@ -0,0 +1,59 @@
+//
+//  SegmentedDataTests.swift
+//  NuguUtilsTests
+//
+//  Created by agent on 2026/10/17.
+//  Copyright (c) 2026 SK Telecom Co., Ltd. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+import XCTest
+
+@testable import NuguUtils
+
+final class SegmentedDataTests: XCTestCase {
+    func testEmptySegmentIsIgnored() {
+        var segmentedData = SegmentedData()
+        segmentedData.append(Data())
+        
+        XCTAssertTrue(segmentedData.isEmpty)
+        XCTAssertEqual(segmentedData.segments.count, 0)
+        XCTAssertEqual(segmentedData.data, Data())
+    }
+    
+    func testSegmentsAreJoinedInOrder() {
+        var segmentedData = SegmentedData(Data("Hello".utf8))
+        segmentedData.append(Data(", ".utf8))
+        segmentedData.append(Data("NUGU".utf8))
+        
+        XCTAssertEqual(segmentedData.segments.count, 3)
+        XCTAssertEqual(segmentedData.count, 11)
+        XCTAssertEqual(segmentedData.data, Data("Hello, NUGU".utf8))
+    }
+    
+    func testSingleSegmentIsNotCopied() {
+        let chunk = Data("--boundary\r\nbody\r\n".utf8)
+        let slice = chunk[12..<16]
+        let segmentedData = SegmentedData(slice)
+        
+        let data = segmentedData.data
+        XCTAssertEqual(data, Data("body".utf8))
+        // The slice is returned as it is. So its indices don't start from zero.
+        XCTAssertEqual(data.startIndex, 12)
+        XCTAssertEqual(
+            data.withUnsafeBytes { $0.baseAddress },
+            slice.withUnsafeBytes { $0.baseAddress }
+        )
+    }
+}
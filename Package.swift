@@ -62,7 +62,7 @@ let package = Package(
         ),
         .target(
             name: "JadeMarble",
-            dependencies: ["NattyLog", "TycheSDK", "TycheCommon", "TycheEpd", "TycheSpeex"],
+            dependencies: ["NattyLog", "NuguUtils", "TycheSDK", "TycheCommon", "TycheEpd", "TycheSpeex"],
             path: "JadeMarble/",
             exclude: ["Info.plist"],
             resources: [.process("Resources/skt_epd_model.raw")],
@@ -145,6 +145,16 @@ let package = Package(
             path: "NuguClientKit/",
             exclude: ["Info.plist", "README.md"]
         ),
+        .testTarget(
+            name: "NuguUtilsTests",
+            dependencies: ["NuguUtils"],
+            path: "NuguUtilsTests/"
+        ),
+        .testTarget(
+            name: "NuguCoreTests",
+            dependencies: ["NuguCore", "NuguUtils", "RxSwift"],
+            path: "NuguCoreTests/"
+        ),
     ],
     swiftLanguageVersions: [.v5]
 )